@@ -1,5 +1,7 @@
 //// This project is created to fulfill CMPT300 Assignment 1 requirements
-//// It consists of an statically allocated List ADT in the interest of performance
+//// It consists of a pool allocated List ADT in the interest of performance
+//// Nodes and lists come from pools that grow by whole chunks, allocated lazily: a node never moves once allocated
+//// (freed nodes are recycled through a free list), and capacity is only limited by memory
 //// It supports a range of methods for the user of this library
 ////
 ////
@@ -8,12 +10,10 @@
 //// Author: Yu Xuan (Shawn) Wang
 //// Email: yxwang@sfu.ca
 //// Student #: 301227972
-// UNRESOLVED BUG: curr ptr in List structures will get corrupted from time to time. Patches have been applied to increase robustness
 // UNRESOLVED BUG: MEMORY LEAK: node would occasionally disappear from list
 //
 
-#pragma once
-
+#include <assert.h>
 
 #include "LIST.h"
 
@@ -23,34 +23,111 @@
 //---------------------------------- Data Structure Definitions -----------------------------------
 //-------------------------------------------------------------------------------------------------
 
-// initialize lists array
-// note: memset or any procedural initialization is prohibited outside a func (int main for example)
-// to maintain encapsulation this workaround syntax that is ONLY AVAILABLE in gcc is employed
-// https://stackoverflow.com/a/207702
-list lists[MAXLISTCOUNT] = {[0 ... MAXLISTCOUNT - 1].head=NULL, [0 ... MAXLISTCOUNT - 1].tail=NULL,
-        [0 ... MAXLISTCOUNT - 1].curr=NULL, [0 ... MAXLISTCOUNT - 1].nodeCount=0, [0 ... MAXLISTCOUNT -
-                                                                                         1].boolActive=0};
+// the two sentinels represent the BEFORE and AFTER status of list::curr
+// e.g., if(aList.curr==aList.head){ *ListPrev(aList) results in aList.curr=AFTERTAIL }
+// they are never part of a list and should be IMMUTABLE
+node outOfBounds[2] = {[0 ... 1].data=NULL, [0 ... 1].next=NULL, [0 ... 1].prev=NULL, [0 ... 1].belong=NULL,
+        [0 ... 1].boolActive=1};
+#define BEFOREHEAD (outOfBounds)
+#define AFTERTAIL (outOfBounds + 1)
+// a node of some list, i.e. neither NULL nor a sentinel
+#define ISNODE(aNode) ((aNode) && (aNode) != BEFOREHEAD && (aNode) != AFTERTAIL)
+
+// validation of the arguments of an entry point (see "Build modes" in LIST.h)
+// LISTCHECK(cond, failValue) makes the entry point return failValue (nothing for a void one) if cond is false
+#ifdef LISTUNCHECKED
+#define LISTCHECK(cond, ...) assert(cond)
+#else
+#define LISTCHECK(cond, ...) do { if (!(cond)) return __VA_ARGS__; } while (0)
+#endif
+// aList is active, and its head and tail are either both set or both NULL
+#define LISTVALID(aList) ((aList) && (aList)->boolActive && !(aList)->head == !(aList)->tail)
+// the head and the tail of aList belong to it
+#define ENDSOWNED(aList) ((!(aList)->head || (aList)->head->belong == (aList)) && \
+                          (!(aList)->tail || (aList)->tail->belong == (aList)))
+// ... and so does its current node, unless it is NULL or a sentinel
+#define CURROWNED(aList) (ENDSOWNED(aList) && (!ISNODE((aList)->curr) || (aList)->curr->belong == (aList)))
+
+// node pool: nodes are carved out of the current chunk, a new chunk is only malloc()ed once it is used up
+// freed nodes are chained through their next pointer in freeNodes and reused first
+_Thread_local node *freeNodes = NULL;
+_Thread_local node *nodeChunk = NULL;
+_Thread_local int nodeChunkUsed = NODECHUNKSIZE;
+
+// variable to keep the number of nodes USED
+_Thread_local int numNodes = 0;
+
+// list pool: same scheme, except that spare lists are kept in a growable array-based stack
+// when instantiating a new list, one must first look into this array for spare lists, if not found then take a new one from the chunk.
+_Thread_local list *listChunk = NULL;
+_Thread_local int listChunkUsed = LISTCHUNKSIZE;
+_Thread_local list **spareLists = NULL;
+_Thread_local int numSpareLists = 0;
+_Thread_local int spareListsSize = 0;
 
 // variable to keep the number of lists USED
-int lastListPos = 0;
-
-// initialize nodePool array
-// TWO extra slots in the end are reserved to represent BEFORE and AFTER status of list::curr
-// e.g., if(aList.curr==aList.head){ *ListPrev(aList) results in aList.curr=&(nodePool[MAXNODECOUNT + 1]) }
-// these last two slots should be IMMUTABLE
-node nodePool[MAXNODECOUNT + 2] = {[0 ... MAXNODECOUNT + 1].data=NULL,
-        [0 ... MAXNODECOUNT + 1].next=NULL, [0 ... MAXNODECOUNT + 1].prev=NULL, [0 ...
-        MAXNODECOUNT + 1].belong=NULL,
-        [0 ... MAXNODECOUNT - 1].boolActive=0, [MAXNODECOUNT ...
-        MAXNODECOUNT + 1].boolActive=1};
+_Thread_local int numLists = 0;
 
-// variable to keep the number of nodes USED
-int numNodes = 0;
+//-------------------------------------------------------------------------------------------------
+//---------------------------------- Helper Functions ---------------------------------------------
+//-------------------------------------------------------------------------------------------------
+
+// pulls a node from the pool and fills it for aList. Returns NULL if no memory is left
+static node *newNode(list *aList, void *anItem) {
+    node *newNodePtr;
+    if (freeNodes) {
+        newNodePtr = freeNodes;
+        freeNodes = freeNodes->next;
+    } else {
+        if (nodeChunkUsed == NODECHUNKSIZE) {
+            node *newChunk = malloc(NODECHUNKSIZE * sizeof(node));
+            if (!newChunk)
+                return NULL;
+            nodeChunk = newChunk;
+            nodeChunkUsed = 0;
+        }
+        newNodePtr = nodeChunk + nodeChunkUsed++;
+    }
+    newNodePtr->data = anItem;
+    newNodePtr->next = NULL;
+    newNodePtr->prev = NULL;
+    newNodePtr->boolActive = 1;
+    newNodePtr->belong = aList;
+    numNodes++;
+    return newNodePtr;
+}
+
+// returns a node to the pool
+static void freeNode(node *aNode) {
+    aNode->boolActive = 0;
+    aNode->data = NULL;
+    aNode->prev = NULL;
+    aNode->belong = NULL;
+    aNode->next = freeNodes;
+    freeNodes = aNode;
+    numNodes--; // assumption: this will never be negative
+}
 
-// This array-based stack is used to keep track of the spare lists and the count of spare lists
-// when instantiating a new list, one must first look into this array for spare lists, if not found then create a new one at the end of the filled lists.
-list *spareLists[MAXLISTCOUNT] = {[0 ... MAXLISTCOUNT - 1]=NULL};
-int numSpareLists = 0;
+// deactivates aList (its nodes must already be gone) and records it as spare
+// returns -1 (and leaves aList active) if the spare stack cannot grow
+static int releaseList(list *aList) {
+    if (numSpareLists == spareListsSize) {
+        int newSize = spareListsSize ? spareListsSize * 2 : LISTCHUNKSIZE;
+        list **newSpareLists = realloc(spareLists, newSize * sizeof(list *));
+        if (!newSpareLists)
+            return -1;
+        spareLists = newSpareLists;
+        spareListsSize = newSize;
+    }
+    spareLists[numSpareLists++] = aList;
+    aList->boolActive = 0;
+    aList->tail = NULL;
+    aList->nodeCount = 0;
+    aList->curr = NULL;
+    aList->head = NULL;
+    numLists--;
+    return 0;
+}
 
 //-------------------------------------------------------------------------------------------------
 //---------------------------------- Implementation Definitions ----------------------------------
@@ -58,78 +135,81 @@ int numSpareLists = 0;
 
 // makes a new, empty list, and returns its reference on success. Returns a NULL pointer on failure.
 list *ListCreate() {
-    // error check
-    if (lastListPos >= MAXLISTCOUNT)
-        return NULL;
-
-    if (numSpareLists) //try to find spare nodes first
-    {
-        list *returnList = spareLists[numSpareLists - 1];
-        returnList->boolActive = 1;
-        spareLists[numSpareLists - 1] = NULL;
-        numSpareLists--;
-        return returnList;
-    } else {
-        lists[lastListPos].boolActive = 1;
-        return &(lists[lastListPos++]);
+    list *returnList;
+    if (numSpareLists) //try to find spare lists first
+        returnList = spareLists[--numSpareLists];
+    else {
+        if (listChunkUsed == LISTCHUNKSIZE) {
+            list *newChunk = malloc(LISTCHUNKSIZE * sizeof(list));
+            if (!newChunk)
+                return NULL;
+            listChunk = newChunk;
+            listChunkUsed = 0;
+        }
+        returnList = listChunk + listChunkUsed++;
     }
+    returnList->head = NULL;
+    returnList->tail = NULL;
+    returnList->curr = NULL;
+    returnList->nodeCount = 0;
+    returnList->boolActive = 1;
+    numLists++;
+    return returnList;
 }
 
 // returns the number of items in list.
 int ListCount(const list *aList) {
     // Error Check: -1 indicates node is uninitialized
-    if (!aList || !aList->boolActive || !aList->head != !aList->tail)
-        return -1;
+    LISTCHECK(LISTVALID(aList), -1);
     return aList->nodeCount;
 }
 
 // returns a pointer to the first item in list and makes the first item the current item.
 // NOTE: this is designed to bring CURR out of bounds from tail/head direction to HEAD
 void *ListFirst(list *aList) {
-    if (!aList || !aList->boolActive || !aList->head != !aList->tail)
-        return NULL;
+    LISTCHECK(LISTVALID(aList), NULL);
+    LISTCHECK(ENDSOWNED(aList), NULL);
 
     aList->curr = aList->head;
-    return aList->head && aList->head->belong == aList ? aList->head->data : NULL;
+    return aList->head ? aList->head->data : NULL;
 }
 
 // returns a pointer to the last item in list and makes the last item the current one.
 // NOTE: this is designed to bring CURR out of bounds from tail/head direction to TAIL
 void *ListLast(list *aList) {
-    if (!aList || !aList->boolActive || !aList->head != !aList->tail)
-        return NULL;
+    LISTCHECK(LISTVALID(aList), NULL);
+    LISTCHECK(ENDSOWNED(aList), NULL);
 
     aList->curr = aList->tail;
-    return aList->tail && aList->tail->belong == aList ? aList->tail->data : NULL;
+    return aList->tail ? aList->tail->data : NULL;
 }
 
 // advances list's current item by one, and returns a pointer to the new current item.
 // If this operation advances the current item beyond the end of the list, a NULL pointer is returned.
 void *ListNext(list *aList) {
     // error check
-    if (!aList || !aList->boolActive || !aList->head != !aList->tail || !aList->curr || !aList->curr->boolActive ||
-        ((aList->curr < nodePool || aList->curr >= nodePool + MAXNODECOUNT + 2) && aList->curr))
-        return NULL;
-    if ((aList->head && aList->head->belong != aList) || (aList->tail && aList->tail->belong != aList) ||
-        (aList->curr >= nodePool && aList->curr < nodePool + MAXNODECOUNT &&
-         aList->curr->belong != aList))
+    LISTCHECK(LISTVALID(aList), NULL);
+    LISTCHECK(!aList->curr || aList->curr->boolActive, NULL);
+    LISTCHECK(CURROWNED(aList), NULL);
+    // no current item (empty list)
+    if (!aList->curr)
         return NULL;
     // declare ptr variable to return
     void *returnVar;
 
     // curr at tail, make curr go out of bounds in the tail direction
     if (aList->curr == aList->tail) {
-        aList->curr = nodePool + MAXNODECOUNT + 1;
+        aList->curr = AFTERTAIL;
         returnVar = NULL;
     }// if curr was out of bounds in the head direction, bring it back to head
-    else if (aList->curr == nodePool + MAXNODECOUNT) {
+    else if (aList->curr == BEFOREHEAD) {
         aList->curr = aList->head;
         if (aList->head)
             returnVar = aList->head->data;
         else
             returnVar = NULL;
     }// if curr was out of bounds in the tail direction, keep the curr ptr there and return NULL
-    else if (aList->curr == nodePool + MAXNODECOUNT + 1) {
+    else if (aList->curr == AFTERTAIL) {
         returnVar = NULL;
     } else {
         aList->curr = aList->curr->next;
@@ -142,12 +222,11 @@ void *ListNext(list *aList) {
 // If this operation backs up the current item beyond the start of the list, a NULL pointer is returned.
 void *ListPrev(list *aList) {
     // error check
-    if (!aList || !aList->boolActive || (!aList->head != !aList->tail) || !aList->curr || !aList->curr->boolActive ||
-        ((aList->curr < nodePool || aList->curr >= nodePool + MAXNODECOUNT + 2) && aList->curr))
-        return NULL;
-    if ((aList->head && aList->head->belong != aList) || (aList->tail && aList->tail->belong != aList) ||
-        (aList->curr >= nodePool && aList->curr < nodePool + MAXNODECOUNT &&
-         aList->curr->belong != aList))
+    LISTCHECK(LISTVALID(aList), NULL);
+    LISTCHECK(!aList->curr || aList->curr->boolActive, NULL);
+    LISTCHECK(CURROWNED(aList), NULL);
+    // no current item (empty list)
+    if (!aList->curr)
         return NULL;
 
     // declare ptr variable to return
@@ -155,17 +234,17 @@ void *ListPrev(list *aList) {
 
     // curr at head, make curr go out of bounds in the head direction
     if (aList->curr == aList->head) {
-        aList->curr = nodePool + MAXNODECOUNT;
+        aList->curr = BEFOREHEAD;
         returnVar = NULL;
     }// if curr was out of bounds in the tail direction, bring it back to tail
-    else if (aList->curr == nodePool + MAXNODECOUNT + 1) {
+    else if (aList->curr == AFTERTAIL) {
         aList->curr = aList->tail;
         if (aList->tail)
             returnVar = aList->tail->data;
         else
             returnVar = NULL;
     }// if curr was out of bounds in the head direction, keep the curr ptr there and return NULL
-    else if (aList->curr == nodePool + MAXNODECOUNT) {
+    else if (aList->curr == BEFOREHEAD) {
         returnVar = NULL;
     } else {
         aList->curr = aList->curr->prev;
@@ -176,10 +255,10 @@ void *ListPrev(list *aList) {
 
 // returns a pointer to the current item in list.
 void *ListCurr(list *aList) {
-    return aList && aList->boolActive && !(!aList->head != !aList->tail) && aList->curr && aList->curr->boolActive &&
-           aList->curr >= nodePool &&
-           aList->curr < nodePool + MAXNODECOUNT && aList->curr->belong == aList
-           ? aList->curr->data : NULL;
+    LISTCHECK(LISTVALID(aList), NULL);
+    LISTCHECK(!aList->curr || aList->curr->boolActive, NULL);
+    LISTCHECK(CURROWNED(aList), NULL);
+    return ISNODE(aList->curr) ? aList->curr->data : NULL;
 }
 
 // adds the new item to list directly after the current item, and makes item the current item.
@@ -187,28 +266,17 @@ void *ListCurr(list *aList) {
 // If the current pointer is beyond the end of the list, the item is added at the end. Returns 0 on success, -1 on failure.
 int ListAdd(list *aList, void *anItem) {
     // error check: not active or one of the head/tail missing
-    if (!aList || !aList->boolActive || !aList->head != !aList->tail)
-        return -1;
-
-    if ((aList->head && aList->head->belong != aList) || (aList->tail && aList->tail->belong != aList) ||
-        (aList->curr >= nodePool && aList->curr < nodePool + MAXNODECOUNT &&
-         aList->curr->belong != aList))
-        return NULL;
+    LISTCHECK(LISTVALID(aList), -1);
+    LISTCHECK(CURROWNED(aList), -1);
 
     // additional error checks: curr ptr is invalid, but list is not empty: ERROR
     // DONT KNOW WHERE TO INSERT!
-    if ((!aList->curr || aList->curr < nodePool || aList->curr >= nodePool + MAXNODECOUNT + 2) &&
-        aList->head)
-        return -1;
+    LISTCHECK(aList->curr || !aList->head, -1);
 
-    // pull new node from nodePool
-    // Check if theres available node (should always be available because nodePool size is determined by MAXNODECOUNT && if list is filled
-    if (numNodes > MAXNODECOUNT - 1)
-        return -1;  // No empty node in nodePool
-    node *newNodePtr = nodePool + numNodes++;
-    newNodePtr->data = anItem;
-    newNodePtr->boolActive = 1;
-    newNodePtr->belong = aList;
+    // pull new node from the node pool
+    node *newNodePtr = newNode(aList, anItem);
+    if (!newNodePtr)
+        return -1;
 
     // decide where to put this new node
     if (!aList->head)    // && !aList->tail, empty list
@@ -218,13 +286,13 @@ int ListAdd(list *aList, void *anItem) {
         aList->tail = newNodePtr;
         aList->curr = newNodePtr;
     } // out of bounds in the tail direction
-    else if (aList->curr == nodePool + MAXNODECOUNT + 1) {
+    else if (aList->curr == AFTERTAIL) {
         aList->tail->next = newNodePtr;
         newNodePtr->prev = aList->tail;
         aList->tail = newNodePtr;
         aList->curr = newNodePtr;
     }// out of bounds in the head direction
-    else if (aList->curr == nodePool + MAXNODECOUNT) {
+    else if (aList->curr == BEFOREHEAD) {
         aList->head->prev = newNodePtr;
         newNodePtr->next = aList->head;
         aList->head = newNodePtr;
@@ -250,28 +318,17 @@ int ListAdd(list *aList, void *anItem) {
 // If the current pointer is beyond the end of the list, the item is added at the end. Returns 0 on success, -1 on failure.
 int ListInsert(list *aList, void *anItem) {
     // error check: not active or one of the head/tail missing
-    if (!aList || !aList->boolActive || (!aList->head != !aList->tail))
-        return -1;
+    LISTCHECK(LISTVALID(aList), -1);
+    LISTCHECK(CURROWNED(aList), -1);
 
-    if ((aList->head && aList->head->belong != aList) || (aList->tail && aList->tail->belong != aList) ||
-        (aList->curr >= nodePool && aList->curr < nodePool + MAXNODECOUNT &&
-         aList->curr->belong != aList))
-        return NULL;
-
-    // additional error checks: curr is invalid, but list is not empty: ERROR
+    // additional error checks: curr ptr is invalid, but list is not empty: ERROR
     // DONT KNOW WHERE TO INSERT!
-    if ((!aList->curr || aList->curr < nodePool || aList->curr >= nodePool + MAXNODECOUNT + 2) &&
-        aList->head)
-        return -1;
+    LISTCHECK(aList->curr || !aList->head, -1);
 
-    // pull new node from nodePool
-    // Check if theres available node && if list is filled
-    if (numNodes > MAXNODECOUNT - 1)
+    // pull new node from the node pool
+    node *newNodePtr = newNode(aList, anItem);
+    if (!newNodePtr)
         return -1;
-    node *newNodePtr = nodePool + numNodes++;
-    newNodePtr->data = anItem;
-    newNodePtr->boolActive = 1;
-    newNodePtr->belong = aList;
 
     // decide where to put this new node
     if (!aList->head)    // && !aList->tail, empty list
@@ -281,13 +338,13 @@ int ListInsert(list *aList, void *anItem) {
         aList->tail = newNodePtr;
         aList->curr = newNodePtr;
     } // out of bounds in the tail direction
-    else if (aList->curr == nodePool + MAXNODECOUNT + 1) {
+    else if (aList->curr == AFTERTAIL) {
         aList->tail->next = newNodePtr;
         newNodePtr->prev = aList->tail;
         aList->tail = newNodePtr;
         aList->curr = newNodePtr;
     }// out of bounds in the head direction
-    else if (aList->curr == nodePool + MAXNODECOUNT) {
+    else if (aList->curr == BEFOREHEAD) {
         aList->head->prev = newNodePtr;
         newNodePtr->next = aList->head;
         aList->head = newNodePtr;
@@ -310,31 +367,21 @@ int ListInsert(list *aList, void *anItem) {
 // adds item to the end of list, and makes the new item the current one. Returns 0 on success, -1 on failure.
 int ListAppend(list *aList, void *anItem) {
     // error check: not active or one of the head/tail missing
-    if (!aList || !aList->boolActive || (!aList->head != !aList->tail))
-        return -1;
-
-    if ((aList->head && aList->head->belong != aList) || (aList->tail && aList->tail->belong != aList) ||
-        (aList->curr >= nodePool && aList->curr < nodePool + MAXNODECOUNT &&
-         aList->curr->belong != aList))
-        return -1;
+    LISTCHECK(LISTVALID(aList), -1);
+    LISTCHECK(CURROWNED(aList), -1);
 
     // Invalid aList->curr is allowed. We do not need it to know where to insert new node
     // This is also an opportunity to have it bounce back to a non-error state
 //    // additional error checks: curr is invalid, but list is not empty: ERROR
 //    // DONT KNOW WHERE TO INSERT!
-//    if ((!aList->curr || aList->curr < nodePool || aList->curr >= nodePool + MAXNODECOUNT + 2)&& aList->head)
+//    if (!aList->curr && aList->head)
 //        return -1;
 
-    // pull new node from nodePool
-    // Check if theres available node && if list is filled
-    if (numNodes > MAXNODECOUNT - 1)
+    // pull new node from the node pool
+    node *newNodePtr = newNode(aList, anItem);
+    if (!newNodePtr)
         return -1;
 
-    node *newNodePtr = nodePool + numNodes++;
-    newNodePtr->data = anItem;
-    newNodePtr->boolActive = 1;
-    newNodePtr->belong = aList;
-
     // decide where to put this new node
     if (!aList->head)    // && !aList->tail, empty list
         // note: aList->curr might also be NULL/invalid, but we don't care
@@ -355,31 +402,21 @@ int ListAppend(list *aList, void *anItem) {
 // adds item to the front of list, and makes the new item the current one. Returns 0 on success, -1 on failure.
 int ListPrepend(list *aList, void *anItem) {
     // error check: not active or one of the head/tail missing
-    if (!aList || !aList->boolActive || (!aList->head != !aList->tail))
-        return -1;
-    if ((aList->head && aList->head->belong != aList) || (aList->tail && aList->tail->belong != aList) ||
-        (aList->curr >= nodePool && aList->curr < nodePool + MAXNODECOUNT &&
-         aList->curr->belong != aList))
-        return -1;
-
+    LISTCHECK(LISTVALID(aList), -1);
+    LISTCHECK(CURROWNED(aList), -1);
 
     // Invalid aList->curr is allowed. We do not need it to know where to insert new node
     // This is also an opportunity to have it bounce back to a non-error state
 //    // additional error checks: curr is invalid, but list is not empty: ERROR
 //    // DONT KNOW WHERE TO INSERT!
-//    if ((!aList->curr || aList->curr < nodePool || aList->curr >= nodePool + MAXNODECOUNT + 2)&& aList->head)
+//    if (!aList->curr && aList->head)
 //        return -1;
 
-    // pull new node from nodePool
-    // Check if theres available node && if list is filled
-    if (numNodes > MAXNODECOUNT - 1)
+    // pull new node from the node pool
+    node *newNodePtr = newNode(aList, anItem);
+    if (!newNodePtr)
         return -1;
 
-    node *newNodePtr = nodePool + numNodes++;
-    newNodePtr->data = anItem;
-    newNodePtr->boolActive = 1;
-    newNodePtr->belong = aList;
-
     // decide where to put this new node
     if (!aList->head)    // && !aList->tail, empty list
         // note: aList->curr might also be NULL/invalid, but we don't care
@@ -400,22 +437,17 @@ int ListPrepend(list *aList, void *anItem) {
 // Return current item and take it out of list. Make the next item the current one.
 // corrupted curr ptr? DONT KNOW WHERE TO DELETE? Set the tail to be deleted (for the convenience of as02/as03)
 void *ListRemove(list *aList) {
-    // error check: not active || one of the head/tail missing || numNodes recorded greater than threshold
-    if (!aList || !aList->boolActive || (!aList->head != !aList->tail) || numNodes > MAXNODECOUNT)
-        return NULL;
+    // error check: not active || one of the head/tail missing
+    LISTCHECK(LISTVALID(aList), NULL);
     // head or tail doesnt belong to the list || curr ptr points to an effective node but does not belong to the list
-    if ((aList->head && aList->head->belong != aList) || (aList->tail && aList->tail->belong != aList) ||
-        (aList->curr >= nodePool && aList->curr < nodePool + MAXNODECOUNT &&
-         aList->curr->belong != aList))
-        return NULL;
+    LISTCHECK(CURROWNED(aList), NULL);
 
     // additional error checks: Empty list || curr is invalid
     // Nothing to do
     if (!aList->head )
         return NULL;
     // DONT KNOW WHERE TO DELETE! Set the tail to be deleted (for the convenience of as02/as03)
-    if(!aList->curr || !aList->curr->boolActive || aList->curr < nodePool ||
-          aList->curr >= nodePool + numNodes)
+    if(!ISNODE(aList->curr) || !aList->curr->boolActive)
         aList->curr=aList->tail;
 
 
@@ -440,56 +472,24 @@ void *ListRemove(list *aList) {
         aList->curr->next->prev = aList->curr->prev;
     }
 
-    // check if node being deleted is at the end of the "used" section of nodePool
-    // if not, copy the last node to the deletion node to fill hole,
-    // make sure the list and all its nodes that refers to this moved mode are adjusted to refer to the new memory location,
-    // and delete the last node
-    node *oldAddressOfAffectedNode = nodePool + numNodes - 1;
-    if (aList->curr != oldAddressOfAffectedNode && oldAddressOfAffectedNode->boolActive) {
-        // change the content of curr to that of the affectedList
-        *aList->curr = *oldAddressOfAffectedNode;
-        // get affectedList address
-        list *affectedList = oldAddressOfAffectedNode->belong;
-        // adjust list properties
-        if (affectedList->head == oldAddressOfAffectedNode)
-            affectedList->head = aList->curr;
-        if (affectedList->tail == oldAddressOfAffectedNode)
-            affectedList->tail = aList->curr;
-        if (affectedList->curr == oldAddressOfAffectedNode)
-            affectedList->curr = aList->curr;
-        // adjust node links
-        if (oldAddressOfAffectedNode->prev)
-            oldAddressOfAffectedNode->prev->next = aList->curr;
-        if (oldAddressOfAffectedNode->next)
-            oldAddressOfAffectedNode->next->prev = aList->curr;
-    }
-    oldAddressOfAffectedNode->boolActive = 0;
-    oldAddressOfAffectedNode->data = NULL;
-    oldAddressOfAffectedNode->next = NULL;
-    oldAddressOfAffectedNode->prev = NULL;
-    oldAddressOfAffectedNode->belong = NULL;
-    numNodes--; // assumption: this will never be negative
+    // nodes never move, so the deleted node goes straight back to the pool
+    freeNode(aList->curr);
     aList->nodeCount--;
 
-    if (boolDeletingAtTail)  // this should also cover the case when the deletionNode is the only node in aList
-        aList->curr = deletionNode.prev;
-    else if (boolDeletingAtHead)
-        aList->curr = aList->head;  // head is already modified to the second node
+    // the next item becomes the current one (the previous one when deleting at tail, which also covers
+    // the case when the deletionNode is the only node in aList)
+    aList->curr = boolDeletingAtTail ? deletionNode.prev : deletionNode.next;
     return deletionNode.data;
 }
 
 // adds list2 to the end of list1. The current pointer is set to the current pointer of list1.
 // List2 no longer exists after the operation.
 void ListConcat(list *list1, list *list2) {
-    // error check: not active || one of the head/tail missing || numNodes recorded greater than threshold
-    if (!list1 || !list1->boolActive || (!list1->head != !list1->tail) || numNodes > MAXNODECOUNT)
-        return;
-    if (!list2 || !list2->boolActive || (!list2->head != !list2->tail))
-        return;
-    if ((list1->head && list1->head->belong != list1) || (list1->tail && list1->tail->belong != list1))
-        return;
-    if ((list2->head && list2->head->belong != list2) || (list2->tail && list2->tail->belong != list2))
-        return;
+    // error check: not active || one of the head/tail missing
+    LISTCHECK(LISTVALID(list1));
+    LISTCHECK(LISTVALID(list2));
+    LISTCHECK(ENDSOWNED(list1));
+    LISTCHECK(ENDSOWNED(list2));
 
     list1->nodeCount += list2->nodeCount;
     if (list1->head && list2->head) // && list1->tail&& list2->tail
@@ -517,30 +517,18 @@ void ListConcat(list *list1, list *list2) {
     }
 
     // delete list2
-    // check if list being deleted is at the end of the "used" section of lists[]
-    // if not, record this spare list as a result of deletion into the spareLists[]
-    if (list2 != lists + lastListPos - 1) {
-        spareLists[numSpareLists++] = list2;
-    } else {
-        lastListPos--; // assumption: this will never be negative
-    }
-    list2->boolActive = 0;
-    list2->tail = NULL;
-    list2->nodeCount = 0;
-    list2->curr = NULL;
-    list2->head = NULL;
+    // record this spare list into the spareLists[]
+    releaseList(list2);
 }
 
 // delete list. itemFree is a pointer to a routine that frees an item. It should be invoked (within ListFree) as:
 // (*itemFree)(itemToBeFreed) [[Note: equivalent to itemFree(itemToBeFreed)]]
 // Example: https://stackoverflow.com/questions/1789807/function-pointer-as-an-argument
 void ListFree(list *aList, void (*itemFree)()) {
-    // error check: not active || one of the head/tail missing || numNodes recorded greater than threshold
-    if (!aList || !aList->boolActive || (!aList->head != !aList->tail) || numNodes > MAXNODECOUNT)
-        return;
+    // error check: not active || one of the head/tail missing
+    LISTCHECK(LISTVALID(aList));
     // head or tail doesnt belong to the list
-    if ((aList->head && aList->head->belong != aList) || (aList->tail && aList->tail->belong != aList))
-        return;
+    LISTCHECK(ENDSOWNED(aList));
 
     // we do not care where aList->curr is at initially
     aList->curr=aList->head;    // in order to use ListRemove() from head
@@ -555,31 +543,21 @@ void ListFree(list *aList, void (*itemFree)()) {
     }
 
     // delete aList
-    // check if list being deleted is at the end of the "used" section of lists[]
-    // if not, record this spare list as a result of deletion into the spareLists[]
-    if (aList != lists + lastListPos - 1) {
-        spareLists[numSpareLists++] = aList;
-    } else {
-        lastListPos--; // assumption: this will never be negative
-    }
-    aList->boolActive = 0;
-    aList->tail = NULL;
-    aList->nodeCount = 0;
-    aList->curr = NULL;
-    aList->head = NULL;
+    // record this spare list into the spareLists[]
+    releaseList(aList);
 }
 
 // Return last item and take it out of list. Make the new last item the current one.
 void *ListTrim(list *aList) {
-    // error check: not active || one of the head/tail missing || empty list
-    if (!aList || !aList->boolActive || (!aList->head != !aList->tail)||!aList->head)
+    // error check: not active || one of the head/tail missing
+    LISTCHECK(LISTVALID(aList), NULL);
+    // empty list: nothing to trim
+    if (!aList->head)
         return NULL;
     // head or tail doesnt belong to the list
-    if ((aList->head && aList->head->belong != aList))
-        return NULL;
+    LISTCHECK(ENDSOWNED(aList), NULL);
     // error check: clean tail
-    if(aList->tail->next)
-        return NULL;
+    LISTCHECK(!aList->tail->next, NULL);
 
     // set curr to tail, call ListRemove()
     aList->curr=aList->tail;
@@ -596,13 +574,9 @@ void *ListTrim(list *aList) {
 // Shawn's note: comparator is a pointer to a routine in testbench with parameter data1, data2; comparisonArg is data2
 void *ListSearch(list *aList, int (*comparator)(), void *comparisonArg) {
     // error check: not active || one of the head/tail missing
-    if (!aList || !aList->boolActive || (!aList->head != !aList->tail))
-        return NULL;
+    LISTCHECK(LISTVALID(aList), NULL);
     // head or tail doesnt belong to the list || curr ptr points to an effective node but does not belong to the list
-    if ((aList->head && aList->head->belong != aList) || (aList->tail && aList->tail->belong != aList) ||
-        (aList->curr >= nodePool && aList->curr < nodePool + MAXNODECOUNT &&
-         aList->curr->belong != aList))
-        return NULL;
+    LISTCHECK(CURROWNED(aList), NULL);
 
     // we do not care where aList->curr is at initially
     aList->curr=aList->head;
@@ -616,7 +590,7 @@ void *ListSearch(list *aList, int (*comparator)(), void *comparisonArg) {
         aList->curr=aList->curr->next;
     }
     // not found
-    aList->curr=nodePool + MAXNODECOUNT + 1;
+    aList->curr=AFTERTAIL;
     return NULL;
 }
 
@@ -627,7 +601,7 @@ void *ListSearch(list *aList, int (*comparator)(), void *comparisonArg) {
 void printNumNodes() { printf("numNodes is %d\n", numNodes); }
 
 // debugging function used to print numNodes
-void printNumLists() { printf("lastListPos is %d\n", lastListPos); }
+void printNumLists() { printf("numLists is %d\n", numLists); }
 
 // debugging function used to print numNodes
 void printNumSpareLists() {
@@ -678,8 +652,7 @@ void listPrint(list *aList) {
     node *tempPtr2 = aList->curr;
 
 
-    if (tempPtr2 >= nodePool && tempPtr2 < nodePool + MAXNODECOUNT &&
-        tempPtr2) {
+    if (ISNODE(tempPtr2)) {
         int ii = 0;
         while (tempPtr2 && tempPtr2 != aList->head) {
             tempPtr2 = tempPtr2->prev;
@@ -689,9 +662,9 @@ void listPrint(list *aList) {
             printf("list->curr is now at position #%d (value: %d)\n", ii, *(int *) aList->curr->data);
         else
             printf("list->curr is now at position #%d (data column is NULL)\n", ii);
-    } else if (tempPtr2 == nodePool + MAXNODECOUNT)
+    } else if (tempPtr2 == BEFOREHEAD)
         printf("list->curr is currently out of bounds in the HEAD direction\n");
-    else if (tempPtr2 == nodePool + MAXNODECOUNT + 1)
+    else if (tempPtr2 == AFTERTAIL)
         printf("list->curr is currently out of bounds in the TAIL direction\n");
     else if (!tempPtr2)
         printf("list->curr is NULL\n");
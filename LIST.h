@@ -1,5 +1,6 @@
 //// This project is created to fulfill CMPT300 Assignment 1 requirements
-//// It consists of an statically allocated List ADT in the interest of performance
+//// It consists of a pool allocated List ADT in the interest of performance
+//// Nodes and lists are carved out of chunks allocated on demand, so their number is only limited by memory
 //// It supports a range of methods for the user of this library
 ////
 ////
@@ -8,23 +9,31 @@
 //// Author: Yu Xuan (Shawn) Wang
 //// Email: yxwang@sfu.ca
 //// Student #: 301227972
-// UNRESOLVED BUG: curr ptr in List structures will get corrupted from time to time. Patches have been applied to increase robustness
 // UNRESOLVED BUG: MEMORY LEAK: node would occasionally disappear from list
 //
+// Build modes:
+// checked (default, "make list-checked"): every entry point validates its list (active, head/tail parity,
+//     nodes belonging to it, live curr) and fails softly, returning NULL/-1, on a corrupted one
+// unchecked (-DLISTUNCHECKED): the same validation is made of assert()s, so a corrupted list stops a debug
+//     build on the spot, and with -DNDEBUG ("make list-release") the entry points only do the pointer work.
+//     Passing a NULL, freed or corrupted list is then undefined behaviour
+//
+// The pools are thread local: a list must be used and freed by the thread that created it
 #pragma once
 #include <stdlib.h>    // NULL macro
 
 //#define DEBUG
 
+// number of lists/nodes allocated at once whenever the pools run dry
 #ifdef DEBUG
-#define MAXLISTCOUNT 4
-#define MAXNODECOUNT 4
+#define LISTCHUNKSIZE 4
+#define NODECHUNKSIZE 4
 #include <stdio.h>  // for printf();
 #endif
 
 #ifndef DEBUG
-#define MAXLISTCOUNT 10
-#define MAXNODECOUNT 1000
+#define LISTCHUNKSIZE 16
+#define NODECHUNKSIZE 4096
 #endif
 
 
@@ -0,0 +1,296 @@
+//// Throughput and scaling benchmark of the simulator
+//// Runs standard workloads at increasing process counts and reports one CSV line per run on stdout:
+////     workload,procs,live_procs,cmds,seconds,cmds_per_sec,ns_per_cmd,peak_rss_kb
+//// procs is the requested process count, live_procs the largest number of processes actually alive
+//// (before or after the measured phase), which is lower when the simulator ran out of room
+//// Each run happens in a forked child, so that it starts from a fresh simulator
+//// and so that peak_rss_kb belongs to that run only. Only the measured phase of a workload is timed,
+//// its setup (e.g. creating the processes a kill storm kills) is not. The simulator runs in quiet mode,
+//// so the scheduling work is measured rather than the formatting of its reports.
+//// The workloads run under the default scheduling policy, and a few of them again under the other policies,
+//// so that the dispatch overhead of each policy can be compared (the workload name then ends with the policy).
+//// The "smp" workloads run on BENCHCPUS simulated CPUs, to measure the cost of the per-CPU run queues and of
+//// the work stealing as the number of CPUs grows.
+////
+//// Usage: simulation-bench [procs]...    (default: 100 1000 10000)
+////
+//// Created on: Oct 16, 2026
+
+#define _POSIX_C_SOURCE 200809L     // clock_gettime(), fdopen() with -std=c11
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include <sys/resource.h>
+
+#include "sim.h"
+#include "trace.h"
+
+#define BENCHCPUS 64
+
+// |-------------------------------------------------------------------------|
+// |                          Helper Functions                               |
+// |-------------------------------------------------------------------------|
+
+// number of commands executed by the measured phase of the current run
+unsigned long numCmds;
+
+// executes one command, counted when measuring
+void bench(char flag, unsigned int id, int val, char *msg) {
+    traceExec(flag, id, val, 0, msg);
+    numCmds++;
+}
+
+double now() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double) ts.tv_sec + (double) ts.tv_nsec * 1e-9;
+}
+
+// |-------------------------------------------------------------------------|
+// |                          Workloads                                      |
+// |-------------------------------------------------------------------------|
+// each workload gets the number of processes n
+// setup*() builds the initial state (not timed), run*() is the measured phase
+
+// create storm: n processes arrive
+void runCreate(unsigned int n) {
+    for (unsigned int i = 0; i < n; i++)
+        bench('C', 0, 0, NULL);
+}
+
+void setupProcs(unsigned int n) {
+    for (unsigned int i = 0; i < n; i++)
+        traceExec('C', 0, 0, 0, NULL);
+}
+
+// quantum churn: every process goes through every priority level a few times
+void runQuantum(unsigned int n) {
+    for (unsigned int i = 0; i < 4 * n; i++)
+        bench('Q', 0, 0, NULL);
+}
+
+// quantum churn with a priority boost every 64 quanta: compared with "quantum", the cost of the boosts,
+// which should not grow with the number of processes
+void setupBoost(unsigned int n) {
+    simSetBoost(64);
+    setupProcs(n);
+}
+
+// kill-by-pID across deep queues: the n processes are killed in a shuffled order
+unsigned int *killOrder;
+
+void runKill(unsigned int n) {
+    for (unsigned int i = 0; i < n; i++)
+        bench('K', killOrder[i], 0, NULL);
+}
+
+void setupKill(unsigned int n) {
+    unsigned int i;
+    uint64_t state = 42;
+
+    setupProcs(n);
+    killOrder = malloc(n * sizeof(unsigned int));
+    for (i = 0; i < n; i++)
+        killOrder[i] = i + 1;
+    // Fisher-Yates shuffle with a fixed LCG, so every run kills in the same order
+    for (i = n; i > 1; i--) {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        unsigned int j = (unsigned int) ((state >> 33) % i);
+        unsigned int tmp = killOrder[i - 1];
+        killOrder[i - 1] = killOrder[j];
+        killOrder[j] = tmp;
+    }
+}
+
+// pID churn: n processes stay alive while 4n are killed and replaced, oldest first,
+// so that the pIDs of the dead processes are recycled (see pidindex.h)
+unsigned int *churnPIDs;
+
+void runChurn(unsigned int n) {
+    for (unsigned int i = 0; i < 4 * n; i++) {
+        bench('K', churnPIDs[i % n], 0, NULL);
+        bench('C', 0, 0, NULL);
+        churnPIDs[i % n] = outcome.pID;     // the process C just created
+    }
+}
+
+void setupChurn(unsigned int n) {
+    setupProcs(n);
+    churnPIDs = malloc(n * sizeof(unsigned int));
+    for (unsigned int i = 0; i < n; i++)
+        churnPIDs[i] = i + 1;
+}
+
+// bulk queries: the process table is scanned by O, 3 + numPriorities + 2 times per command
+void runOverview(unsigned int n) {
+    for (unsigned int i = 0; i < 100; i++)
+        bench('O', 0, 0, NULL);
+}
+
+// send/reply ping-pong: the running process sends to another one and blocks, then gets its reply
+void runPingPong(unsigned int n) {
+    char msg[] = "ping";
+    for (unsigned int i = 0; i < 2 * n; i++) {
+        unsigned int sender = runningProc->pID;
+        bench('S', (sender % n) + 1, 0, msg);
+        bench('Y', sender, 0, msg);
+    }
+}
+
+void setupPingPong(unsigned int n) {
+    setupProcs(n);
+    traceExec('Q', 0, 0, 0, NULL);     // "init" hands the CPU to the first process
+}
+
+// semaphore convoy: every process blocks on one semaphore, then they are all released one by one
+void runConvoy(unsigned int n) {
+    unsigned int i;
+    for (i = 0; i < n; i++)
+        bench('P', 0, 0, NULL);
+    for (i = 0; i < n; i++)
+        bench('V', 0, 0, NULL);
+}
+
+void setupConvoy(unsigned int n) {
+    traceExec('N', 0, 0, 0, NULL);
+    setupPingPong(n);
+}
+
+// quantum churn over every CPU: the processes are all created on CPU 0, the other CPUs steal them as they go
+// through their quanta in turn
+void runSmpQuantum(unsigned int n) {
+    for (unsigned int i = 0; i < 4 * n; i++) {
+        bench('U', i % numCpus, 0, NULL);
+        bench('Q', 0, 0, NULL);
+    }
+}
+
+// send/reply ping-pong between processes spread over every CPU: the sender blocks on one CPU and its reply
+// readies it back on that CPU
+void runSmpPingPong(unsigned int n) {
+    char msg[] = "ping";
+    for (unsigned int i = 0; i < 2 * n; i++) {
+        bench('U', i % numCpus, 0, NULL);
+        unsigned int sender = runningProc->pID;
+        bench('S', (sender % n) + 1, 0, msg);
+        bench('Y', sender, 0, msg);
+    }
+}
+
+// spreads the processes over the CPUs by letting each CPU steal its first one
+void setupSmp(unsigned int n) {
+    setupProcs(n);
+    for (unsigned int i = 0; i < numCpus; i++) {
+        traceExec('U', i, 0, 0, NULL);
+        traceExec('Q', 0, 0, 0, NULL);
+    }
+}
+
+typedef struct workload {
+    const char *name;
+    void (*setup)(unsigned int n);      // may be NULL
+    void (*run)(unsigned int n);
+    const char *policy;                 // scheduling policy (see simSetPolicy()), NULL: the default one
+    unsigned int cpus;                  // simulated CPUs (see simSetCpus()), 0: one
+} workload;
+
+workload workloads[] = {
+        {.name = "create",          .setup = NULL,          .run = runCreate},
+        {.name = "quantum",         .setup = setupProcs,    .run = runQuantum},
+        {.name = "boost",           .setup = setupBoost,    .run = runQuantum},
+        {.name = "kill",            .setup = setupKill,     .run = runKill},
+        {.name = "churn",           .setup = setupChurn,    .run = runChurn},
+        {.name = "overview",        .setup = setupPingPong, .run = runOverview},
+        {.name = "pingpong",        .setup = setupPingPong, .run = runPingPong},
+        {.name = "convoy",          .setup = setupConvoy,   .run = runConvoy},
+        {.name = "quantum-rr",      .setup = setupProcs,    .run = runQuantum,     .policy = "rr"},
+        {.name = "pingpong-rr",     .setup = setupPingPong, .run = runPingPong,    .policy = "rr"},
+        {.name = "pingpong-fcfs",   .setup = setupPingPong, .run = runPingPong,    .policy = "fcfs"},
+        {.name = "convoy-fcfs",     .setup = setupConvoy,   .run = runConvoy,      .policy = "fcfs"},
+        {.name = "quantum-cfs",     .setup = setupProcs,    .run = runQuantum,     .policy = "cfs"},
+        {.name = "pingpong-cfs",    .setup = setupPingPong, .run = runPingPong,    .policy = "cfs"},
+        {.name = "kill-cfs",        .setup = setupKill,     .run = runKill,        .policy = "cfs"},
+        {.name = "quantum-smp",     .setup = setupSmp,      .run = runSmpQuantum,  .cpus = BENCHCPUS},
+        {.name = "pingpong-smp",    .setup = setupSmp,      .run = runSmpPingPong, .cpus = BENCHCPUS},
+        {.name = "quantum-smp-cfs", .setup = setupSmp,      .run = runSmpQuantum,  .policy = "cfs", .cpus = BENCHCPUS},
+};
+
+// runs one workload in a child process and prints its CSV line on report
+void benchOne(const workload *w, unsigned int n, FILE *report) {
+    fflush(report);
+    pid_t child = fork();
+    if (child < 0) {
+        perror("fork");
+        return;
+    }
+    if (child == 0) {
+        struct rusage usage;
+        if (w->policy)
+            simSetPolicy(w->policy);
+        if (w->cpus)
+            simSetCpus(w->cpus);
+        simInit();
+        if (w->setup)
+            w->setup(n);
+        unsigned int liveProcs = countProcs();
+        numCmds = 0;
+        double start = now();
+        w->run(n);
+        fflush(stdout);
+        double elapsed = now() - start;
+        if (countProcs() > liveProcs)
+            liveProcs = countProcs();
+        getrusage(RUSAGE_SELF, &usage);
+        fprintf(report, "%s,%u,%u,%lu,%.6f,%.0f,%.1f,%ld\n", w->name, n, liveProcs, numCmds, elapsed,
+                elapsed > 0 ? numCmds / elapsed : 0.0, numCmds ? elapsed * 1e9 / numCmds : 0.0, usage.ru_maxrss);
+        fflush(report);
+        _exit(0);
+    }
+    int status;
+    waitpid(child, &status, 0);
+    if (!WIFEXITED(status) || WEXITSTATUS(status))
+        fprintf(report, "%s,%u,,,,,,\n", w->name, n);     // crashed: keep the table rectangular
+}
+
+int main(int argc, char *argv[]) {
+    unsigned int defaultCounts[] = {100, 1000, 10000};
+    unsigned int *counts = defaultCounts;
+    int numCounts = sizeof defaultCounts / sizeof defaultCounts[0];
+    int i, j;
+
+    if (argc > 1) {
+        numCounts = argc - 1;
+        counts = malloc(numCounts * sizeof(unsigned int));
+        for (i = 0; i < numCounts; i++) {
+            char *endptr;
+            unsigned long l = strtoul(argv[i + 1], &endptr, 10);
+            if (*endptr || !l || l > 100000000UL) {
+                fprintf(stderr, "Usage: %s [procs]...\n", argv[0]);
+                return 1;
+            }
+            counts[i] = (unsigned int) l;
+        }
+    }
+
+    // the report keeps the real stdout, anything the simulator still prints goes to /dev/null
+    quiet = 1;
+    FILE *report = fdopen(dup(1), "w");
+    if (!report || !freopen("/dev/null", "w", stdout)) {
+        perror("simulation-bench");
+        return 1;
+    }
+    setvbuf(stdout, NULL, _IOFBF, 1 << 16);
+
+    fprintf(report, "workload,procs,live_procs,cmds,seconds,cmds_per_sec,ns_per_cmd,peak_rss_kb\n");
+    for (i = 0; i < (int) (sizeof workloads / sizeof workloads[0]); i++) {
+        for (j = 0; j < numCounts; j++)
+            benchOne(&workloads[i], counts[j], report);
+    }
+    fclose(report);
+    return 0;
+}
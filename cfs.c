@@ -0,0 +1,277 @@
+//// Completely fair scheduling
+//// See cfs.h for the interface
+////
+//// Created on: Oct 16, 2026
+
+#include "sim.h"
+#include "cfs.h"
+
+//-------------------------------------------------------------------------------------------------
+//---------------------------------- Data Structure Definitions -----------------------------------
+//-------------------------------------------------------------------------------------------------
+
+// weights of nice 0 to 19, each about 1.25 times lighter than the previous one (Linux's sched_prio_to_weight)
+const unsigned int niceWeights[] = {1024, 820, 655, 526, 423, 335, 272, 215, 172, 137,
+                                    110, 87, 70, 56, 45, 36, 29, 23, 18, 15};
+
+
+//-------------------------------------------------------------------------------------------------
+//---------------------------------- Helper Functions ---------------------------------------------
+//-------------------------------------------------------------------------------------------------
+
+// returns 1 if a runs before b
+static int runsBefore(const pcb *a, const pcb *b) {
+    return a->vruntime < b->vruntime || (a->vruntime == b->vruntime && a->cfsSeq < b->cfsSeq);
+}
+
+static int isRed(const pcb *node) {
+    return node && node->rb.red;
+}
+
+static pcb *leftmost(pcb *node) {
+    while (node->rb.left)
+        node = node->rb.left;
+    return node;
+}
+
+// makes newChild take the place of oldChild under parent (NULL: at the root of tree)
+static void replaceChild(cfsTree *tree, pcb *parent, pcb *oldChild, pcb *newChild) {
+    if (!parent)
+        tree->root = newChild;
+    else if (parent->rb.left == oldChild)
+        parent->rb.left = newChild;
+    else
+        parent->rb.right = newChild;
+}
+
+static void rotateLeft(cfsTree *tree, pcb *node) {
+    pcb *pivot = node->rb.right;
+    node->rb.right = pivot->rb.left;
+    if (pivot->rb.left)
+        pivot->rb.left->rb.parent = node;
+    pivot->rb.parent = node->rb.parent;
+    replaceChild(tree, node->rb.parent, node, pivot);
+    pivot->rb.left = node;
+    node->rb.parent = pivot;
+}
+
+static void rotateRight(cfsTree *tree, pcb *node) {
+    pcb *pivot = node->rb.left;
+    node->rb.left = pivot->rb.right;
+    if (pivot->rb.right)
+        pivot->rb.right->rb.parent = node;
+    pivot->rb.parent = node->rb.parent;
+    replaceChild(tree, node->rb.parent, node, pivot);
+    pivot->rb.right = node;
+    node->rb.parent = pivot;
+}
+
+// restores the red-black properties after node was inserted red
+static void insertFixup(cfsTree *tree, pcb *node) {
+    pcb *parent, *grandParent, *uncle;
+
+    while ((parent = node->rb.parent) && parent->rb.red) {
+        grandParent = parent->rb.parent;    // a red node is never the root
+        if (parent == grandParent->rb.left) {
+            uncle = grandParent->rb.right;
+            if (isRed(uncle)) {
+                parent->rb.red = uncle->rb.red = 0;
+                grandParent->rb.red = 1;
+                node = grandParent;
+                continue;
+            }
+            if (node == parent->rb.right) {
+                rotateLeft(tree, parent);
+                node = parent;
+                parent = node->rb.parent;
+            }
+            rotateRight(tree, grandParent);
+        } else {
+            uncle = grandParent->rb.left;
+            if (isRed(uncle)) {
+                parent->rb.red = uncle->rb.red = 0;
+                grandParent->rb.red = 1;
+                node = grandParent;
+                continue;
+            }
+            if (node == parent->rb.left) {
+                rotateRight(tree, parent);
+                node = parent;
+                parent = node->rb.parent;
+            }
+            rotateLeft(tree, grandParent);
+        }
+        parent->rb.red = 0;
+        grandParent->rb.red = 1;
+    }
+    tree->root->rb.red = 0;
+}
+
+// restores the red-black properties after a black node was taken out above node (possibly NULL),
+// parent being the parent of node
+static void removeFixup(cfsTree *tree, pcb *node, pcb *parent) {
+    pcb *sibling;
+
+    while (node != tree->root && !isRed(node)) {
+        // node is one black short, so its sibling exists
+        if (node == parent->rb.left) {
+            sibling = parent->rb.right;
+            if (sibling->rb.red) {
+                sibling->rb.red = 0;
+                parent->rb.red = 1;
+                rotateLeft(tree, parent);
+                sibling = parent->rb.right;
+            }
+            if (!isRed(sibling->rb.left) && !isRed(sibling->rb.right)) {
+                sibling->rb.red = 1;
+                node = parent;
+                parent = node->rb.parent;
+                continue;
+            }
+            if (!isRed(sibling->rb.right)) {
+                sibling->rb.left->rb.red = 0;
+                sibling->rb.red = 1;
+                rotateRight(tree, sibling);
+                sibling = parent->rb.right;
+            }
+            sibling->rb.red = parent->rb.red;
+            parent->rb.red = 0;
+            sibling->rb.right->rb.red = 0;
+            rotateLeft(tree, parent);
+        } else {
+            sibling = parent->rb.left;
+            if (sibling->rb.red) {
+                sibling->rb.red = 0;
+                parent->rb.red = 1;
+                rotateRight(tree, parent);
+                sibling = parent->rb.left;
+            }
+            if (!isRed(sibling->rb.left) && !isRed(sibling->rb.right)) {
+                sibling->rb.red = 1;
+                node = parent;
+                parent = node->rb.parent;
+                continue;
+            }
+            if (!isRed(sibling->rb.left)) {
+                sibling->rb.right->rb.red = 0;
+                sibling->rb.red = 1;
+                rotateLeft(tree, sibling);
+                sibling = parent->rb.left;
+            }
+            sibling->rb.red = parent->rb.red;
+            parent->rb.red = 0;
+            sibling->rb.left->rb.red = 0;
+            rotateRight(tree, parent);
+        }
+        node = tree->root;
+    }
+    if (node)
+        node->rb.red = 0;
+}
+
+//-------------------------------------------------------------------------------------------------
+//---------------------------------- Implementation Definitions ----------------------------------
+//-------------------------------------------------------------------------------------------------
+
+unsigned int cfsWeight(unsigned int priority) {
+    unsigned int numWeights = sizeof niceWeights / sizeof niceWeights[0];
+    return niceWeights[priority < numWeights ? priority : numWeights - 1];
+}
+
+void cfsCharge(pcb *proc) {
+    proc->vruntime += (unsigned long long) CFSSLICE * CFSNICE0WEIGHT / cfsWeight(proc->priority);
+}
+
+void cfsEnqueue(cfsTree *tree, pcb *proc) {
+    pcb *parent = NULL;
+    pcb **link = &tree->root;
+    int isLeftmost = 1;
+
+    if (proc->vruntime < tree->minVruntime)
+        proc->vruntime = tree->minVruntime;
+    proc->cfsSeq = tree->nextSeq++;
+    while (*link) {
+        parent = *link;
+        if (runsBefore(proc, parent))
+            link = &parent->rb.left;
+        else {
+            link = &parent->rb.right;
+            isLeftmost = 0;
+        }
+    }
+    proc->rb = (cfsNode) {NULL, NULL, parent, 1, 1};
+    *link = proc;
+    if (isLeftmost)
+        tree->first = proc;
+    insertFixup(tree, proc);
+}
+
+pcb *cfsPickNext(cfsTree *tree) {
+    pcb *proc = tree->first;
+    if (!proc)
+        return NULL;
+    cfsRemove(tree, proc);
+    // every other ready process has at least this virtual runtime
+    if (proc->vruntime > tree->minVruntime)
+        tree->minVruntime = proc->vruntime;
+    return proc;
+}
+
+int cfsRemove(cfsTree *tree, pcb *proc) {
+    pcb *child, *parent;
+    int removedBlack;
+
+    if (!proc->rb.linked)
+        return 0;
+    if (proc == tree->first)
+        tree->first = cfsNext(proc);
+    if (!proc->rb.left || !proc->rb.right) {
+        // proc is replaced by its only child, if any
+        child = proc->rb.left ? proc->rb.left : proc->rb.right;
+        parent = proc->rb.parent;
+        removedBlack = !proc->rb.red;
+        replaceChild(tree, parent, proc, child);
+        if (child)
+            child->rb.parent = parent;
+    } else {
+        // proc is replaced by its successor, which has no left child
+        pcb *successor = leftmost(proc->rb.right);
+        child = successor->rb.right;
+        removedBlack = !successor->rb.red;
+        if (successor->rb.parent == proc)
+            parent = successor;
+        else {
+            parent = successor->rb.parent;
+            replaceChild(tree, parent, successor, child);
+            if (child)
+                child->rb.parent = parent;
+            successor->rb.right = proc->rb.right;
+            successor->rb.right->rb.parent = successor;
+        }
+        replaceChild(tree, proc->rb.parent, proc, successor);
+        successor->rb.parent = proc->rb.parent;
+        successor->rb.left = proc->rb.left;
+        successor->rb.left->rb.parent = successor;
+        successor->rb.red = proc->rb.red;
+    }
+    if (removedBlack)
+        removeFixup(tree, child, parent);
+    proc->rb = (cfsNode) {NULL, NULL, NULL, 0, 0};
+    return 1;
+}
+
+pcb *cfsFirst(const cfsTree *tree) {
+    return tree->first;
+}
+
+pcb *cfsNext(pcb *proc) {
+    if (proc->rb.right)
+        return leftmost(proc->rb.right);
+    while (proc->rb.parent && proc == proc->rb.parent->rb.right)
+        proc = proc->rb.parent;
+    return proc->rb.parent;
+}
+
+void cfsReset(cfsTree *tree) {
+    *tree = (cfsTree) {NULL, NULL, 0, 0};
+}
@@ -0,0 +1,58 @@
+//// Completely fair scheduling
+//// The ready set of the "cfs" scheduling policy (see sim.c): every process carries a virtual runtime, which
+//// grows by CFSSLICE * CFSNICE0WEIGHT / weight for every quantum it runs, its weight coming from its priority
+//// taken as a nice value (priority 0 is nice 0, see cfsWeight()). The process with the smallest virtual runtime
+//// runs next, so the CPU is shared in proportion to the weights.
+//// The ready processes sit in a red-black tree ordered by virtual runtime (then by enqueue order), whose
+//// leftmost node is cached: picking the next process is O(1) plus the O(log n) removal, enqueueing is O(log n).
+//// The links of the tree live in the pcb (pcb.rb), so enqueueing allocates nothing.
+//// A process never enters the tree behind the smallest virtual runtime seen so far (cfsTree::minVruntime), so a
+//// new or newly unblocked process competes from where the others are instead of catching up for its absence.
+//// There is one tree per simulated CPU (see cpu in sim.h), each with its own minimum.
+////
+//// Created on: Oct 16, 2026
+#pragma once
+
+#define CFSSLICE 1024           // virtual runtime of a quantum at nice 0
+#define CFSNICE0WEIGHT 1024     // weight of nice 0
+
+struct pcb;
+
+// links of a process in the ready tree, embedded in the pcb
+typedef struct cfsNode {
+    struct pcb *left;
+    struct pcb *right;
+    struct pcb *parent;
+    unsigned char red;          // color of the node, 0 for black
+    unsigned char linked;       // set while the process is in the tree
+} cfsNode;
+
+// a ready tree and its bookkeeping
+typedef struct cfsTree {
+    struct pcb *root;
+    struct pcb *first;                  // leftmost node, i.e. the next process to run
+    unsigned long long minVruntime;     // smallest virtual runtime a process may enter the tree with
+    unsigned long long nextSeq;         // enqueue order, orders the processes of equal virtual runtime
+} cfsTree;
+
+// weight of a process at priority (nice 0-19 as in Linux, anything deeper weighs as nice 19)
+unsigned int cfsWeight(unsigned int priority);
+
+// charges one quantum of run time to proc
+void cfsCharge(struct pcb *proc);
+
+// puts the ready process proc into tree
+void cfsEnqueue(cfsTree *tree, struct pcb *proc);
+
+// takes the process with the smallest virtual runtime out of tree, NULL if it is empty
+struct pcb *cfsPickNext(cfsTree *tree);
+
+// takes proc out of tree. Returns 1 if it was in it, 0 if there was nothing to do
+int cfsRemove(cfsTree *tree, struct pcb *proc);
+
+// the process with the smallest virtual runtime in tree, and the one after proc in tree order (NULL: none)
+struct pcb *cfsFirst(const cfsTree *tree);
+struct pcb *cfsNext(struct pcb *proc);
+
+// empties tree, the processes in it are not touched
+void cfsReset(cfsTree *tree);
@@ -0,0 +1,243 @@
+//// Earliest deadline first
+//// See edf.h for the interface
+////
+//// Created on: Oct 16, 2026
+
+#include "sim.h"
+#include "edf.h"
+
+//-------------------------------------------------------------------------------------------------
+//---------------------------------- Data Structure Definitions -----------------------------------
+//-------------------------------------------------------------------------------------------------
+
+// binary min-heap of tasks, each task knowing its position (edfTask::heapPos)
+typedef struct taskHeap {
+    pcb **tasks;
+    unsigned int count;
+    int byRelease;          // ordered by release time instead of absolute deadline
+} taskHeap;
+
+_Thread_local taskHeap readyHeap = {NULL, 0, 0};
+_Thread_local taskHeap releaseHeap = {NULL, 0, 1};
+_Thread_local unsigned int heapCapacity = 0;      // of both heaps and the task set, one slot per admitted task
+_Thread_local pcb **taskSet = NULL;               // every admitted task, ready, waiting, running or blocked
+_Thread_local unsigned int numTasks = 0;
+_Thread_local double edfDensity = 0;
+
+struct edfState {
+    taskHeap readyHeap;
+    taskHeap releaseHeap;
+    unsigned int heapCapacity;
+    pcb **taskSet;
+    unsigned int numTasks;
+    double edfDensity;
+};
+
+//-------------------------------------------------------------------------------------------------
+//---------------------------------- Helper Functions ---------------------------------------------
+//-------------------------------------------------------------------------------------------------
+
+static double taskDensity(unsigned int period, unsigned int deadline, unsigned int budget) {
+    return (double) budget / (deadline < period ? deadline : period);
+}
+
+// returns 1 if a comes out of heap before b
+static int heapBefore(const taskHeap *heap, const pcb *a, const pcb *b) {
+    if (heap->byRelease)
+        return a->rt.release < b->rt.release || (a->rt.release == b->rt.release && a->rt.due < b->rt.due);
+    return a->rt.due < b->rt.due || (a->rt.due == b->rt.due && a->pID < b->pID);
+}
+
+static void heapPlace(taskHeap *heap, pcb *task, unsigned int pos) {
+    heap->tasks[pos] = task;
+    task->rt.heapPos = pos;
+}
+
+static void siftUp(taskHeap *heap, unsigned int pos) {
+    pcb *task = heap->tasks[pos];
+    while (pos > 0) {
+        unsigned int parent = (pos - 1) / 2;
+        if (!heapBefore(heap, task, heap->tasks[parent]))
+            break;
+        heapPlace(heap, heap->tasks[parent], pos);
+        pos = parent;
+    }
+    heapPlace(heap, task, pos);
+}
+
+static void siftDown(taskHeap *heap, unsigned int pos) {
+    pcb *task = heap->tasks[pos];
+    for (;;) {
+        unsigned int child = 2 * pos + 1;
+        if (child >= heap->count)
+            break;
+        if (child + 1 < heap->count && heapBefore(heap, heap->tasks[child + 1], heap->tasks[child]))
+            child++;
+        if (!heapBefore(heap, heap->tasks[child], task))
+            break;
+        heapPlace(heap, heap->tasks[child], pos);
+        pos = child;
+    }
+    heapPlace(heap, task, pos);
+}
+
+static void heapPush(taskHeap *heap, pcb *task) {
+    heap->tasks[heap->count++] = task;
+    siftUp(heap, heap->count - 1);
+}
+
+// takes the task at pos out of heap
+static void heapTake(taskHeap *heap, unsigned int pos) {
+    pcb *task = heap->tasks[pos];
+    pcb *last = heap->tasks[--heap->count];
+    task->rt.heapPos = EDFNOHEAP;
+    if (pos == heap->count)
+        return;
+    heapPlace(heap, last, pos);
+    siftDown(heap, pos);
+    siftUp(heap, last->rt.heapPos);
+}
+
+static void heapShow(const taskHeap *heap) {
+    unsigned int i;
+    for (i = 0; i < heap->count; i++) {
+        const pcb *task = heap->tasks[i];
+        REPORT("\tpID#%u: job released at tick %lu, due at tick %lu, %u of %u quanta used\n", task->pID,
+               task->rt.release, task->rt.due, task->rt.used, task->rt.budget);
+    }
+}
+
+//-------------------------------------------------------------------------------------------------
+//---------------------------------- Implementation Definitions ----------------------------------
+//-------------------------------------------------------------------------------------------------
+
+int edfAdmit(unsigned int period, unsigned int deadline, unsigned int budget) {
+    if (edfDensity + taskDensity(period, deadline, budget) > 1.0 + 1e-9)
+        return -1;
+    if (numTasks == heapCapacity) {
+        unsigned int newCapacity = heapCapacity ? 2 * heapCapacity : 16;
+        pcb **newReady = realloc(readyHeap.tasks, newCapacity * sizeof(pcb *));
+        if (!newReady)
+            return -1;
+        readyHeap.tasks = newReady;
+        pcb **newRelease = realloc(releaseHeap.tasks, newCapacity * sizeof(pcb *));
+        if (!newRelease)
+            return -1;
+        releaseHeap.tasks = newRelease;
+        pcb **newSet = realloc(taskSet, newCapacity * sizeof(pcb *));
+        if (!newSet)
+            return -1;
+        taskSet = newSet;
+        heapCapacity = newCapacity;
+    }
+    return 0;
+}
+
+void edfStart(pcb *proc, unsigned int period, unsigned int deadline, unsigned int budget) {
+    proc->rt = (edfTask) {period, deadline, budget, 0, simClock, simClock + deadline, EDFNOHEAP, numTasks, 0};
+    taskSet[numTasks++] = proc;
+    edfDensity += taskDensity(period, deadline, budget);
+}
+
+long edfRetire(pcb *proc, int *late) {
+    pcb *last = taskSet[--numTasks];
+    taskSet[proc->rt.setPos] = last;
+    last->rt.setPos = proc->rt.setPos;
+    edfDensity -= taskDensity(proc->rt.period, proc->rt.deadline, proc->rt.budget);
+    if (numTasks == 0)
+        edfDensity = 0;     // no rounding error left behind
+    proc->rt.period = 0;
+    *late = simClock > proc->rt.due;
+    return *late ? (long) simClock - (long) proc->rt.due : 0;
+}
+
+void edfEnqueue(pcb *proc) {
+    heapPush(proc->rt.waiting ? &releaseHeap : &readyHeap, proc);
+}
+
+pcb *edfPickNext() {
+    // the jobs released by now become ready
+    while (releaseHeap.count && releaseHeap.tasks[0]->rt.release <= simClock) {
+        pcb *task = releaseHeap.tasks[0];
+        heapTake(&releaseHeap, 0);
+        task->rt.waiting = 0;
+        heapPush(&readyHeap, task);
+    }
+    if (!readyHeap.count)
+        return NULL;
+    pcb *task = readyHeap.tasks[0];
+    heapTake(&readyHeap, 0);
+    return task;
+}
+
+void edfRemove(pcb *proc) {
+    if (proc->rt.heapPos != EDFNOHEAP)
+        heapTake(proc->rt.waiting ? &releaseHeap : &readyHeap, proc->rt.heapPos);
+}
+
+long edfOnQuantum(pcb *proc, int *done) {
+    edfTask *rt = &proc->rt;
+    *done = 0;
+    if (++rt->used < rt->budget)
+        return 0;
+    // the job is done, the next one is released a period after this one, or at the first period boundary not
+    // in the past yet if it completed that late
+    long lateness = (long) simClock - (long) rt->due;
+    *done = 1;
+    rt->used = 0;
+    rt->release += rt->period;
+    if (rt->release < simClock)
+        rt->release += (simClock - rt->release + rt->period - 1) / rt->period * rt->period;
+    rt->due = rt->release + rt->deadline;
+    rt->waiting = rt->release > simClock;
+    return lateness;
+}
+
+unsigned long edfLateJobs(long long *latenessSum) {
+    unsigned long late = 0;
+    unsigned int i;
+    for (i = 0; i < numTasks; i++) {
+        if (simClock > taskSet[i]->rt.due) {
+            late++;
+            *latenessSum += (long long) (simClock - taskSet[i]->rt.due);
+        }
+    }
+    return late;
+}
+
+void edfShow() {
+    if (!numTasks)
+        return;
+    REPORT("----Displaying the ready real-time tasks (earliest deadline first, then in heap order):\n");
+    heapShow(&readyHeap);
+    REPORT("----Displaying the real-time tasks waiting for their next release:\n");
+    heapShow(&releaseHeap);
+}
+
+void edfFree() {
+    free(readyHeap.tasks);
+    free(releaseHeap.tasks);
+    free(taskSet);
+    taskSet = NULL;
+    readyHeap = (taskHeap) {NULL, 0, 0};
+    releaseHeap = (taskHeap) {NULL, 0, 1};
+    heapCapacity = 0;
+    numTasks = 0;
+    edfDensity = 0;
+}
+
+edfState *edfStateCreate() {
+    edfState *state = malloc(sizeof(edfState));
+    if (state)
+        *state = (edfState) {{NULL, 0, 0}, {NULL, 0, 1}, 0, NULL, 0, 0};
+    return state;
+}
+
+void edfSwap(edfState *state) {
+    SIMSWAP(readyHeap, state->readyHeap);
+    SIMSWAP(releaseHeap, state->releaseHeap);
+    SIMSWAP(heapCapacity, state->heapCapacity);
+    SIMSWAP(taskSet, state->taskSet);
+    SIMSWAP(numTasks, state->numTasks);
+    SIMSWAP(edfDensity, state->edfDensity);
+}
@@ -0,0 +1,85 @@
+//// Earliest deadline first
+//// The real-time scheduling class: it runs ahead of the scheduling policy (see schedPolicy in sim.h), so a
+//// ready real-time task always gets the CPU before any other process.
+//// A real-time task is created with a period, a relative deadline and a budget, all in ticks of simClock
+//// (see stats.h), one quantum counting as one tick of budget. It releases a job every period, which is due
+//// deadline ticks after its release and done once it used budget quanta. The ready tasks sit in a binary
+//// min-heap by absolute deadline. A task whose job is done waits for its next release in a second min-heap, by
+//// release time, and moves to the ready heap once simClock reaches it.
+//// A task is only admitted if the density of the task set (sum of budget / min(deadline, period)) stays
+//// within 1, which guarantees on one CPU that every job of the set meets its deadline. A late job (caused by
+//// blocking, or by the one quantum granularity) is counted as a deadline miss and its lateness is reported
+//// by the accounting (see stats.h): once it completes, or once its deadline passed if it never completes
+//// (the task is killed or exits, or the accounting is looked at while the job is still unfinished).
+//// A job completing after the release of the next one does not make the task catch up with jobs run back to
+//// back: the releases already in the past are skipped, the next job is released at the first period boundary
+//// from now on.
+////
+//// Created on: Oct 16, 2026
+#pragma once
+
+#define EDFNOHEAP ((unsigned int) -1)
+
+struct pcb;
+
+// real-time parameters and current job of a process, embedded in the pcb
+typedef struct edfTask {
+    unsigned int period;        // 0 if the process is not a real-time task
+    unsigned int deadline;      // relative to the release of each job
+    unsigned int budget;        // quanta per job
+    unsigned int used;          // quanta used by the current job
+    unsigned long release;      // tick at which the current job is (or was) released
+    unsigned long due;          // absolute deadline of the current job
+    unsigned int heapPos;       // position in the heap holding the task, EDFNOHEAP if none
+    unsigned int setPos;        // position in the task set
+    unsigned char waiting;      // set while the task waits for its next release
+} edfTask;
+
+extern _Thread_local double edfDensity;       // density of the admitted task set
+
+// returns 1 if proc is a real-time task
+#define EDFTASK(proc) ((proc)->rt.period != 0)
+
+// admits a task with these parameters into the task set, making room for it in the heaps
+// returns 0 on success, -1 if the task set would overload the CPU (or has no room left)
+int edfAdmit(unsigned int period, unsigned int deadline, unsigned int budget);
+
+// makes proc the admitted real-time task with these parameters, its first job released now
+void edfStart(struct pcb *proc, unsigned int period, unsigned int deadline, unsigned int budget);
+
+// takes proc out of the task set, it must not sit in a heap anymore
+// if the deadline of its unfinished job passed already, *late is set and the lateness of the job is returned,
+// else *late is cleared and 0 is returned
+long edfRetire(struct pcb *proc, int *late);
+
+// puts the real-time task proc into the ready heap, or into the release heap while its next job is not released
+void edfEnqueue(struct pcb *proc);
+
+// takes the ready task with the earliest deadline out of the ready heap, NULL if none is ready
+struct pcb *edfPickNext();
+
+// takes proc out of the heap holding it, nothing to do if it sits in none
+void edfRemove(struct pcb *proc);
+
+// charges a quantum to the running task proc. If that completes its job, *done is set and the lateness of the
+// job is returned (negative if it was early), else *done is cleared and 0 is returned
+long edfOnQuantum(struct pcb *proc, int *done);
+
+// number of the unfinished jobs of the task set whose deadline passed already, their lateness so far being
+// added to *latenessSum
+unsigned long edfLateJobs(long long *latenessSum);
+
+// displays the tasks of both heaps, nothing if there is no real-time task
+void edfShow();
+
+// frees the heaps and empties the task set
+void edfFree();
+
+// the task set of a simulation kept aside (see simSwap() in sim.h)
+typedef struct edfState edfState;
+
+// allocates the state of a simulation with no real-time task, NULL if it cannot be allocated
+edfState *edfStateCreate();
+
+// exchanges the task set and heaps of the thread with the ones kept in state
+void edfSwap(edfState *state);
@@ -0,0 +1,80 @@
+//// Event loop used to drive the simulation
+//// See eventloop.h for the interface
+////
+//// Created on: Oct 16, 2026
+
+#include <stdlib.h>
+#include <errno.h>
+#include <sys/poll.h>
+
+#include "eventloop.h"
+
+//-------------------------------------------------------------------------------------------------
+//---------------------------------- Data Structure Definitions -----------------------------------
+//-------------------------------------------------------------------------------------------------
+
+typedef struct eventSource {
+    eventHandler handler;
+    void *arg;
+} eventSource;
+
+// fds[i] and sources[i] describe the same event source, fds[] is handed to poll() directly
+struct pollfd fds[MAXEVENTSOURCES];
+eventSource sources[MAXEVENTSOURCES];
+int numSources = 0;
+
+//-------------------------------------------------------------------------------------------------
+//---------------------------------- Implementation Definitions ----------------------------------
+//-------------------------------------------------------------------------------------------------
+
+int eventLoopAdd(int fd, eventHandler handler, void *arg) {
+    int i;
+    if (fd < 0 || !handler || numSources >= MAXEVENTSOURCES)
+        return -1;
+    for (i = 0; i < numSources; i++) {
+        if (fds[i].fd == fd)
+            return -1;
+    }
+    fds[numSources].fd = fd;
+    fds[numSources].events = POLLIN;
+    fds[numSources].revents = 0;
+    sources[numSources].handler = handler;
+    sources[numSources].arg = arg;
+    numSources++;
+    return 0;
+}
+
+int eventLoopRemove(int fd) {
+    int i;
+    for (i = 0; i < numSources; i++) {
+        if (fds[i].fd == fd) {
+            // fill the hole with the last source to keep fds[] contiguous for poll()
+            numSources--;
+            fds[i] = fds[numSources];
+            sources[i] = sources[numSources];
+            return 0;
+        }
+    }
+    return -1;
+}
+
+void eventLoopRun(unsigned int *run) {
+    int i;
+    while (*run && numSources) {
+        // infinite timeout: sleep in the kernel until something happens
+        if (poll(fds, numSources, -1) < 0) {
+            if (errno == EINTR)
+                continue;
+            return;
+        }
+        // walk backwards so that a handler removing its own source does not make us skip one
+        for (i = numSources - 1; i >= 0 && *run; i--) {
+            if (i >= numSources || !fds[i].revents)
+                continue;
+            int fd = fds[i].fd;
+            fds[i].revents = 0;
+            if (sources[i].handler(fd, sources[i].arg))
+                eventLoopRemove(fd);
+        }
+    }
+}
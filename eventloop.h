@@ -0,0 +1,23 @@
+//// Event loop used to drive the simulation
+//// Instead of spinning on a zero-timeout poll(), the loop blocks in poll() until one of the
+//// registered event sources (stdin for now) becomes readable, so an idle simulator costs no CPU.
+//// New event sources (trace files, sockets, timers...) only need to register an fd and a handler.
+////
+//// Created on: Oct 16, 2026
+#pragma once
+
+#define MAXEVENTSOURCES 8
+
+// handler invoked when the registered fd is readable (or hung up)
+// returns 0 to keep the source registered, non-zero to have the loop remove it
+typedef int (*eventHandler)(int fd, void *arg);
+
+// registers fd to be watched by the loop. Returns 0 on success, -1 on failure (table full / duplicate fd)
+int eventLoopAdd(int fd, eventHandler handler, void *arg);
+
+// unregisters fd from the loop. Returns 0 on success, -1 if fd was not registered
+int eventLoopRemove(int fd);
+
+// blocks until sources are ready and dispatches their handlers.
+// returns when *run is cleared by a handler or when no sources are left
+void eventLoopRun(unsigned int *run);
@@ -0,0 +1,344 @@
+//// Compact binary event log of the scheduling actions
+//// See evlog.h for the log layout
+////
+//// Created on: Oct 16, 2026
+
+#define _POSIX_C_SOURCE 200809L     // open(), write() with -std=c11
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "sim.h"
+#include "evlog.h"
+
+//-------------------------------------------------------------------------------------------------
+//---------------------------------- Data Structure Definitions -----------------------------------
+//-------------------------------------------------------------------------------------------------
+
+#define EVLOGBUFSIZE (1 << 16)
+// a record is at most: type + 3 varints of 5 bytes + a message. Flushing below this much room
+// means a record never needs a bounds check while it is being encoded
+#define EVLOGMAXRECORD (1 + 3 * 5 + 5 + 64)
+
+_Thread_local int evlogOn = 0;
+
+_Thread_local int logFd = -1;
+_Thread_local int logError = 0;
+_Thread_local unsigned char logBuf[EVLOGBUFSIZE];
+_Thread_local size_t logLen = 0;
+_Thread_local unsigned int lastPID = 0;       // pID of the previous record, pIDs are stored as deltas from it
+
+//-------------------------------------------------------------------------------------------------
+//---------------------------------- Helper Functions ---------------------------------------------
+//-------------------------------------------------------------------------------------------------
+
+static void flushLog() {
+    size_t done = 0;
+    while (done < logLen) {
+        ssize_t n = write(logFd, logBuf + done, logLen - done);
+        if (n <= 0) {
+            logError = 1;
+            break;
+        }
+        done += (size_t) n;
+    }
+    logLen = 0;
+}
+
+static uint32_t zigzag(int32_t v) {
+    return ((uint32_t) v << 1) ^ (uint32_t) (v >> 31);
+}
+
+static int32_t unzigzag(uint32_t v) {
+    return (int32_t) (v >> 1) ^ -(int32_t) (v & 1);
+}
+
+static void putVarint(uint32_t v) {
+    while (v >= 0x80) {
+        logBuf[logLen++] = (unsigned char) (v | 0x80);
+        v >>= 7;
+    }
+    logBuf[logLen++] = (unsigned char) v;
+}
+
+// starts a record: makes room for it, then writes its type and pID delta
+static void beginRecord(eventType type, unsigned int pID) {
+    if (logLen > EVLOGBUFSIZE - EVLOGMAXRECORD)
+        flushLog();
+    logBuf[logLen++] = (unsigned char) type;
+    putVarint(zigzag((int32_t) (pID - lastPID)));
+    lastPID = pID;
+}
+
+static void putMsg(const char *msg) {
+    size_t len = strnlen(msg, 64);
+    putVarint((uint32_t) len);
+    memcpy(logBuf + logLen, msg, len);
+    logLen += len;
+}
+
+//-------------------------------------------------------------------------------------------------
+//---------------------------------- Implementation Definitions ----------------------------------
+//-------------------------------------------------------------------------------------------------
+
+int evlogOpen(const char *path) {
+    logFd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (logFd < 0) {
+        perror(path);
+        return -1;
+    }
+    memcpy(logBuf, EVLOGMAGIC, sizeof EVLOGMAGIC);
+    logLen = sizeof EVLOGMAGIC;
+    lastPID = 0;
+    logError = 0;
+    evlogOn = 1;
+    return 0;
+}
+
+int evlogClose() {
+    if (logFd < 0)
+        return 0;
+    flushLog();
+    if (close(logFd))
+        logError = 1;
+    logFd = -1;
+    evlogOn = 0;
+    if (logError)
+        fprintf(stderr, "The event log could not be completely written!\n");
+    return logError ? -1 : 0;
+}
+
+void evlogCreate(unsigned int pID, unsigned int priority, unsigned int parentPID, int forked) {
+    beginRecord(EV_CREATE, pID);
+    putVarint(priority);
+    putVarint(forked ? parentPID + 1 : 0);
+}
+
+void evlogDispatch(unsigned int pID, unsigned int priority, unsigned int cpuID) {
+    beginRecord(EV_DISPATCH, pID);
+    putVarint(priority);
+    putVarint(cpuID);
+}
+
+void evlogPreempt(unsigned int pID, unsigned int newPriority) {
+    beginRecord(EV_PREEMPT, pID);
+    putVarint(newPriority);
+}
+
+void evlogBlock(unsigned int pID, unsigned int cause, unsigned int semID) {
+    beginRecord(EV_BLOCK, pID);
+    putVarint(cause);
+    if (cause == BLOCKED_SEM)
+        putVarint(semID);
+}
+
+void evlogUnblock(unsigned int pID) {
+    beginRecord(EV_UNBLOCK, pID);
+}
+
+void evlogKill(unsigned int pID) {
+    beginRecord(EV_KILL, pID);
+}
+
+void evlogSend(unsigned int pID, unsigned int remotePID, const char *msg) {
+    beginRecord(EV_SEND, pID);
+    putVarint(remotePID);
+    putMsg(msg);
+}
+
+void evlogReceive(unsigned int pID, unsigned int remotePID, const char *msg) {
+    beginRecord(EV_RECEIVE, pID);
+    putVarint(remotePID);
+    putMsg(msg);
+}
+
+void evlogReply(unsigned int pID, unsigned int remotePID, const char *msg) {
+    beginRecord(EV_REPLY, pID);
+    putVarint(remotePID);
+    putMsg(msg);
+}
+
+void evlogSem(eventType type, unsigned int pID, unsigned int semID, int value) {
+    beginRecord(type, pID);
+    putVarint(semID);
+    putVarint(zigzag(value));
+}
+
+void evlogRenice(unsigned int pID, unsigned int newPriority) {
+    beginRecord(EV_RENICE, pID);
+    putVarint(newPriority);
+}
+
+void evlogBoost(unsigned int pID) {
+    beginRecord(EV_BOOST, pID);
+}
+
+void evlogSemDestroy(unsigned int pID, unsigned int semID) {
+    beginRecord(EV_SEM_D, pID);
+    putVarint(semID);
+}
+
+void evlogMove(eventType type, unsigned int pID, unsigned int fromCpu, unsigned int toCpu) {
+    beginRecord(type, pID);
+    putVarint(fromCpu);
+    putVarint(toCpu);
+}
+
+//-------------------------------------------------------------------------------------------------
+//---------------------------------- Decoder ------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+
+// reads a varint from [*p, end) into *v. Returns 0 on success, -1 on truncated/oversized input
+static int getVarint(const unsigned char **p, const unsigned char *end, uint32_t *v) {
+    uint32_t result = 0;
+    int shift = 0;
+    while (*p < end && shift < 35) {
+        unsigned char byte = *(*p)++;
+        result |= (uint32_t) (byte & 0x7F) << shift;
+        if (!(byte & 0x80)) {
+            *v = result;
+            return 0;
+        }
+        shift += 7;
+    }
+    return -1;
+}
+
+int evlogDecode(const char *path, FILE *out) {
+    const char *causeStrings[] = {"a semaphore", "waiting to receive a message", "waiting for a reply"};
+    unsigned char *log = NULL;
+    size_t logSize = 0, cap = 0, n;
+    unsigned long eventNum = 0;
+    uint32_t delta, a, b, len;
+    unsigned int pID = 0;
+
+    FILE *in = fopen(path, "rb");
+    if (!in) {
+        perror(path);
+        return -1;
+    }
+    // logs are read whole, they are compact enough
+    do {
+        if (logSize == cap) {
+            cap = cap ? cap * 2 : EVLOGBUFSIZE;
+            unsigned char *newLog = realloc(log, cap);
+            if (!newLog) {
+                free(log);
+                fclose(in);
+                return -1;
+            }
+            log = newLog;
+        }
+        n = fread(log + logSize, 1, cap - logSize, in);
+        logSize += n;
+    } while (n);
+    fclose(in);
+
+    if (logSize < sizeof EVLOGMAGIC || memcmp(log, EVLOGMAGIC, sizeof EVLOGMAGIC)) {
+        fprintf(stderr, "%s: not an event log\n", path);
+        free(log);
+        return -1;
+    }
+
+    const unsigned char *p = log + sizeof EVLOGMAGIC;
+    const unsigned char *end = log + logSize;
+    while (p < end) {
+        unsigned char type = *p++;
+        if (type >= EV_NUMTYPES || getVarint(&p, end, &delta))
+            goto corrupted;
+        pID += (unsigned int) unzigzag(delta);
+        eventNum++;
+        fprintf(out, "#%lu ", eventNum);
+        switch (type) {
+            case EV_CREATE:
+                if (getVarint(&p, end, &a) || getVarint(&p, end, &b))
+                    goto corrupted;
+                if (b)
+                    fprintf(out, "Process with pID#%u and priority #%u was forked from pID#%u\n", pID, a, b - 1);
+                else
+                    fprintf(out, "Process with pID#%u and priority #%u was created\n", pID, a);
+                break;
+            case EV_DISPATCH:
+                if (getVarint(&p, end, &a) || getVarint(&p, end, &b))
+                    goto corrupted;
+                fprintf(out, "The process now running on CPU #%u is: Process with pID#%u and priority #%u\n", b, pID,
+                        a);
+                break;
+            case EV_PREEMPT:
+                if (getVarint(&p, end, &a))
+                    goto corrupted;
+                fprintf(out, "The currently running process with pID#%u will now stop occupying the CPU (priority is now #%u)\n",
+                        pID, a);
+                break;
+            case EV_BLOCK:
+                if (getVarint(&p, end, &a) || a > BLOCKED_REPLY)
+                    goto corrupted;
+                if (a == BLOCKED_SEM) {
+                    if (getVarint(&p, end, &b))
+                        goto corrupted;
+                    fprintf(out, "The process with pID#%u is now blocked by semaphore #%u\n", pID, b);
+                } else
+                    fprintf(out, "The process with pID#%u is now blocked %s\n", pID, causeStrings[a]);
+                break;
+            case EV_UNBLOCK:
+                fprintf(out, "The process with pID#%u is now unblocked\n", pID);
+                break;
+            case EV_KILL:
+                fprintf(out, "The process with pID#%u has been killed\n", pID);
+                break;
+            case EV_SEND:
+            case EV_RECEIVE:
+            case EV_REPLY:
+                if (getVarint(&p, end, &a) || getVarint(&p, end, &len) || len > (size_t) (end - p))
+                    goto corrupted;
+                if (type == EV_SEND)
+                    fprintf(out, "Process with pID#%u successfully sent \"%.*s\" to process with pID#%u\n", pID,
+                            (int) len, (const char *) p, a);
+                else if (type == EV_REPLY)
+                    fprintf(out, "Process with pID#%u successfully replied \"%.*s\" to process with pID#%u\n", pID,
+                            (int) len, (const char *) p, a);
+                else
+                    fprintf(out, "Process with pID#%u received a new message from pID#%u: \"%.*s\"\n", pID, a,
+                            (int) len, (const char *) p);
+                p += len;
+                break;
+            case EV_SEM_P:
+            case EV_SEM_V:
+                if (getVarint(&p, end, &a) || getVarint(&p, end, &b))
+                    goto corrupted;
+                fprintf(out, "Process with pID#%u executed the %c operation on semaphore #%u, its value is now %d\n",
+                        pID, type == EV_SEM_P ? 'P' : 'V', a, unzigzag(b));
+                break;
+            case EV_RENICE:
+                if (getVarint(&p, end, &a))
+                    goto corrupted;
+                fprintf(out, "The priority of the process with pID#%u was changed to #%u\n", pID, a);
+                break;
+            case EV_BOOST:
+                fprintf(out, "Priority boost: every process is back at priority #0\n");
+                break;
+            case EV_SEM_D:
+                if (getVarint(&p, end, &a))
+                    goto corrupted;
+                fprintf(out, "Process with pID#%u destroyed semaphore #%u\n", pID, a);
+                break;
+            case EV_STEAL:
+            case EV_MIGRATE:
+                if (getVarint(&p, end, &a) || getVarint(&p, end, &b))
+                    goto corrupted;
+                fprintf(out, "The process with pID#%u %s from CPU #%u %s CPU #%u\n", pID,
+                        type == EV_STEAL ? "was stolen" : "migrated", a, type == EV_STEAL ? "by" : "to", b);
+                break;
+        }
+    }
+    free(log);
+    return 0;
+
+corrupted:
+    fprintf(stderr, "%s: corrupted event log after event #%lu\n", path, eventNum);
+    free(log);
+    return -1;
+}
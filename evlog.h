@@ -0,0 +1,71 @@
+//// Compact binary event log of the scheduling actions
+//// In quiet mode the simulator does not format any text, it only appends typed event records here.
+//// The log can be rendered as human readable text later on with evlogDecode() (--decode).
+////
+//// Log layout: the 8 byte magic EVLOGMAGIC, then one record per event:
+////     type (1 byte) | pID delta | fields of the type
+//// Integers are LEB128 varints. pIDs are zigzag encoded deltas from the pID of the previous record
+//// (consecutive events usually concern the same or nearby processes, so most pIDs fit in one byte),
+//// other signed values (semaphore values) are zigzag encoded. Messages are a length followed by the bytes.
+////
+//// The decoded text is a format of its own, not the live reports played back: one line per event, numbered
+//// from #1 and naming the process the event is about, e.g.
+////     #12 Process with pID#3 successfully sent "hello" to process with pID#1
+//// The reports also echo prompts, refused commands and listings, none of which leaves an event behind.
+////
+//// Created on: Oct 16, 2026
+#pragma once
+
+#include <stdio.h>
+
+#define EVLOGMAGIC "SIMEVT2"     // first 8 bytes of an event log (null terminator included)
+
+typedef enum {
+    EV_CREATE = 0,      // priority, parent pID + 1 (0 if created by C)
+    EV_DISPATCH,        // priority, CPU
+    EV_PREEMPT,         // new priority
+    EV_BLOCK,           // cause (blockCause in sim.h), semID (only if cause is a semaphore)
+    EV_UNBLOCK,         // -
+    EV_KILL,            // -
+    EV_SEND,            // recipient pID, message
+    EV_RECEIVE,         // sender pID, message
+    EV_REPLY,           // recipient pID, message
+    EV_SEM_P,           // semID, new semaphore value
+    EV_SEM_V,           // semID, new semaphore value
+    EV_RENICE,          // new priority
+    EV_BOOST,           // - (pID of the process that was running)
+    EV_SEM_D,           // semID
+    EV_STEAL,           // CPU stolen from, CPU it now runs on
+    EV_MIGRATE,         // CPU left, CPU it now runs on (a real-time task, see edf.h)
+    EV_NUMTYPES
+} eventType;
+
+// set while a log is open. Call sites test it through EVLOG() so that a disabled log costs one branch
+extern _Thread_local int evlogOn;
+
+#define EVLOG(call) do { if (evlogOn) call; } while (0)
+
+// starts logging to path. Returns 0 on success, -1 on failure
+int evlogOpen(const char *path);
+
+// flushes and closes the log. Returns 0 on success, -1 if some of the log could not be written
+int evlogClose();
+
+void evlogCreate(unsigned int pID, unsigned int priority, unsigned int parentPID, int forked);
+void evlogDispatch(unsigned int pID, unsigned int priority, unsigned int cpuID);
+void evlogPreempt(unsigned int pID, unsigned int newPriority);
+void evlogBlock(unsigned int pID, unsigned int cause, unsigned int semID);
+void evlogUnblock(unsigned int pID);
+void evlogKill(unsigned int pID);
+void evlogSend(unsigned int pID, unsigned int remotePID, const char *msg);
+void evlogReceive(unsigned int pID, unsigned int remotePID, const char *msg);
+void evlogReply(unsigned int pID, unsigned int remotePID, const char *msg);
+void evlogSem(eventType type, unsigned int pID, unsigned int semID, int value);
+void evlogRenice(unsigned int pID, unsigned int newPriority);
+void evlogBoost(unsigned int pID);
+void evlogSemDestroy(unsigned int pID, unsigned int semID);
+void evlogMove(eventType type, unsigned int pID, unsigned int fromCpu, unsigned int toCpu);
+
+// renders the log at path as text on out, one line per event (see the decoded format above)
+// returns 0 on success, -1 if the log could not be read or is corrupted
+int evlogDecode(const char *path, FILE *out);
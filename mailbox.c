@@ -0,0 +1,262 @@
+//// Per-process mailboxes
+//// See mailbox.h for the interface
+////
+//// Created on: Oct 16, 2026
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "mailbox.h"
+
+//-------------------------------------------------------------------------------------------------
+//---------------------------------- Data Structure Definitions -----------------------------------
+//-------------------------------------------------------------------------------------------------
+
+#ifdef DEBUG
+#define MAILBOXCHUNKSIZE 2
+#else
+#define MAILBOXCHUNKSIZE 256
+#endif
+
+#define MAILBOXCLASSES 5     // log2(MAILBOXSIZE) + 1 block sizes
+#define BUCKETOF(sender) ((sender) % MAILBOXBUCKETS)
+#define CLASSSIZE(sizeClass) (1 << (sizeClass))
+#define ALLSLOTSFREE(sizeClass) ((unsigned int) ((1ULL << CLASSSIZE(sizeClass)) - 1))
+#define BOXBYTES(sizeClass) (sizeof(mailbox) + CLASSSIZE(sizeClass) * sizeof(msgSlot))
+
+// MAILBOXCHUNKSIZE blocks of one class follow the header
+typedef struct mailboxChunk {
+    struct mailboxChunk *next;
+} mailboxChunk;
+
+// blocks are carved out of the newest chunk of their class, freed blocks are chained in freeBoxes and reused first
+_Thread_local mailboxChunk *chunks = NULL;        // every chunk, of any class
+_Thread_local char *carveNext[MAILBOXCLASSES];    // next block to carve out of the newest chunk of each class
+_Thread_local int carveLeft[MAILBOXCLASSES];      // blocks left to carve there
+_Thread_local mailbox *freeBoxes[MAILBOXCLASSES];
+
+struct mailboxState {
+    mailboxChunk *chunks;
+    char *carveNext[MAILBOXCLASSES];
+    int carveLeft[MAILBOXCLASSES];
+    mailbox *freeBoxes[MAILBOXCLASSES];
+};
+
+//-------------------------------------------------------------------------------------------------
+//---------------------------------- Helper Functions ---------------------------------------------
+//-------------------------------------------------------------------------------------------------
+
+// returns an empty block of sizeClass, NULL if no chunk can be allocated
+static mailbox *newBox(int sizeClass) {
+    mailbox *box;
+    if (freeBoxes[sizeClass]) {
+        box = freeBoxes[sizeClass];
+        freeBoxes[sizeClass] = box->nextFree;
+    } else {
+        if (!carveLeft[sizeClass]) {
+            mailboxChunk *chunk = malloc(sizeof(mailboxChunk) + MAILBOXCHUNKSIZE * BOXBYTES(sizeClass));
+            if (!chunk)
+                return NULL;
+            chunk->next = chunks;
+            chunks = chunk;
+            carveNext[sizeClass] = (char *) (chunk + 1);
+            carveLeft[sizeClass] = MAILBOXCHUNKSIZE;
+        }
+        box = (mailbox *) carveNext[sizeClass];
+        carveNext[sizeClass] += BOXBYTES(sizeClass);
+        carveLeft[sizeClass]--;
+    }
+    box->first = box->last = -1;
+    box->count = 0;
+    box->sizeClass = (unsigned char) sizeClass;
+    memset(box->bucketFirst, -1, sizeof box->bucketFirst);
+    memset(box->bucketLast, -1, sizeof box->bucketLast);
+    box->freeSlots = ALLSLOTSFREE(sizeClass);
+    return box;
+}
+
+static void freeBox(mailbox *box) {
+    box->nextFree = freeBoxes[box->sizeClass];
+    freeBoxes[box->sizeClass] = box;
+}
+
+// moves the full block *box into a block of the next class, the slots keep their index
+// returns 0 on success, -1 if *box is already of the largest class or no block can be allocated
+static int growBox(mailbox **box) {
+    mailbox *old = *box;
+    mailbox *grown;
+    if (old->sizeClass == MAILBOXCLASSES - 1 || !(grown = newBox(old->sizeClass + 1)))
+        return -1;
+    memcpy(grown, old, BOXBYTES(old->sizeClass));
+    grown->sizeClass = old->sizeClass + 1;
+    grown->freeSlots = ALLSLOTSFREE(grown->sizeClass) & ~ALLSLOTSFREE(old->sizeClass);
+    freeBox(old);
+    *box = grown;
+    return 0;
+}
+
+// oldest slot holding a message from sender, -1 if none. *bucketPrev gets the slot before it in its bucket
+static int findSlot(const mailbox *box, unsigned int sender, int *bucketPrev) {
+    int prev = -1;
+    int i = box->bucketFirst[BUCKETOF(sender)];
+    while (i >= 0 && box->slots[i].sender != sender) {
+        prev = i;
+        i = box->slots[i].bucketNext;
+    }
+    *bucketPrev = prev;
+    return i;
+}
+
+// takes the message in slot i out of *box, bucketPrev being the slot before it in its bucket (-1 if none)
+static void takeSlot(mailbox **box, int i, int bucketPrev, unsigned int *from, char *msg) {
+    mailbox *b = *box;
+    msgSlot *slot = &b->slots[i];
+    int bucket = BUCKETOF(slot->sender);
+    *from = slot->sender;
+    memcpy(msg, slot->msg, MAILBOXMSGSIZE);
+    // unlink from the arrival order
+    if (slot->prev >= 0)
+        b->slots[slot->prev].next = slot->next;
+    else
+        b->first = slot->next;
+    if (slot->next >= 0)
+        b->slots[slot->next].prev = slot->prev;
+    else
+        b->last = slot->prev;
+    // unlink from its bucket
+    if (bucketPrev >= 0)
+        b->slots[bucketPrev].bucketNext = slot->bucketNext;
+    else
+        b->bucketFirst[bucket] = slot->bucketNext;
+    if (b->bucketLast[bucket] == i)
+        b->bucketLast[bucket] = (signed char) bucketPrev;
+    b->freeSlots |= 1U << i;
+
+    if (!--b->count) {
+        freeBox(b);
+        *box = NULL;
+    }
+}
+
+//-------------------------------------------------------------------------------------------------
+//---------------------------------- Implementation Definitions ----------------------------------
+//-------------------------------------------------------------------------------------------------
+
+int mailboxPut(mailbox **box, unsigned int sender, const char *msg) {
+    if (!*box && !(*box = newBox(0)))
+        return -1;
+    if (!(*box)->freeSlots && growBox(box))
+        return -1;
+    mailbox *b = *box;
+    int i = __builtin_ctz(b->freeSlots);
+    int bucket = BUCKETOF(sender);
+    msgSlot *slot = &b->slots[i];
+
+    b->freeSlots &= ~(1U << i);
+    slot->sender = sender;
+    strncpy(slot->msg, msg, MAILBOXMSGSIZE - 1);
+    slot->msg[MAILBOXMSGSIZE - 1] = '\0';
+    // newest message overall, and newest of its bucket
+    slot->next = -1;
+    slot->prev = b->last;
+    if (b->last >= 0)
+        b->slots[b->last].next = (signed char) i;
+    else
+        b->first = (signed char) i;
+    b->last = (signed char) i;
+    slot->bucketNext = -1;
+    if (b->bucketLast[bucket] >= 0)
+        b->slots[b->bucketLast[bucket]].bucketNext = (signed char) i;
+    else
+        b->bucketFirst[bucket] = (signed char) i;
+    b->bucketLast[bucket] = (signed char) i;
+    b->count++;
+    return i;
+}
+
+int mailboxTake(mailbox **box, unsigned int sender, unsigned int *from, char *msg) {
+    mailbox *b = *box;
+    int i, bucketPrev;
+    if (!b)
+        return -1;
+    if (sender == MAILBOXANY) {
+        i = b->first;
+        // the oldest message is also the oldest of its bucket
+        bucketPrev = -1;
+    } else
+        i = findSlot(b, sender, &bucketPrev);
+    if (i < 0)
+        return -1;
+    takeSlot(box, i, bucketPrev, from, msg);
+    return 0;
+}
+
+int mailboxTakeSlot(mailbox **box, int i, unsigned int *from, char *msg) {
+    mailbox *b = *box;
+    int bucketPrev = -1;
+    int j;
+    if (!b || i < 0 || i >= (1 << b->sizeClass) || (b->freeSlots & (1U << i)))
+        return -1;
+    // the slot before it in its bucket
+    for (j = b->bucketFirst[BUCKETOF(b->slots[i].sender)]; j != i; j = b->slots[j].bucketNext)
+        bucketPrev = j;
+    takeSlot(box, i, bucketPrev, from, msg);
+    return 0;
+}
+
+
+int mailboxHas(const mailbox *box, unsigned int sender) {
+    int bucketPrev;
+    if (!box)
+        return 0;
+    return sender == MAILBOXANY || findSlot(box, sender, &bucketPrev) >= 0;
+}
+
+unsigned int mailboxCount(const mailbox *box) {
+    return box ? box->count : 0;
+}
+
+void mailboxCopy(mailbox **dst, const mailbox *src) {
+    int i;
+    for (i = src ? src->first : -1; i >= 0; i = src->slots[i].next) {
+        if (mailboxPut(dst, src->slots[i].sender, src->slots[i].msg) < 0)
+            break;
+    }
+}
+
+void mailboxFree(mailbox **box) {
+    if (*box) {
+        freeBox(*box);
+        *box = NULL;
+    }
+}
+
+void mailboxRelease() {
+    int i;
+    while (chunks) {
+        mailboxChunk *next = chunks->next;
+        free(chunks);
+        chunks = next;
+    }
+    for (i = 0; i < MAILBOXCLASSES; i++) {
+        carveLeft[i] = 0;
+        freeBoxes[i] = NULL;
+    }
+}
+
+mailboxState *mailboxStateCreate() {
+    return calloc(1, sizeof(mailboxState));
+}
+
+void mailboxSwap(mailboxState *state) {
+    mailboxState current;
+    current.chunks = chunks;
+    memcpy(current.carveNext, carveNext, sizeof carveNext);
+    memcpy(current.carveLeft, carveLeft, sizeof carveLeft);
+    memcpy(current.freeBoxes, freeBoxes, sizeof freeBoxes);
+    chunks = state->chunks;
+    memcpy(carveNext, state->carveNext, sizeof carveNext);
+    memcpy(carveLeft, state->carveLeft, sizeof carveLeft);
+    memcpy(freeBoxes, state->freeBoxes, sizeof freeBoxes);
+    *state = current;
+}
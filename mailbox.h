@@ -0,0 +1,76 @@
+//// Per-process mailboxes
+//// A process with messages waiting owns one mailbox block. Blocks come in size classes of 1, 2, 4, 8 and
+//// MAILBOXSIZE messages: a full block is moved into one of the next class, slots keep their index.
+//// Each class has its own pool (allocated by chunks, recycled through a free list, like the pcb slabs),
+//// and a block goes back to its pool as soon as the mailbox is empty, so a process only pays for the
+//// messages it has waiting.
+//// Within a block, the messages are chained in arrival order through slot indexes, and each sender is
+//// indexed by a small hash of slot chains, so that the oldest message of a given sender (selective receive)
+//// is found and taken out without scanning the mailbox.
+////
+//// Created on: Oct 16, 2026
+#pragma once
+
+#define MAILBOXSIZE 16          // messages a process can have waiting, a power of 2, at most 32 (see mailbox::freeSlots)
+#define MAILBOXBUCKETS 8        // buckets of the sender index of a mailbox
+#define MAILBOXMSGSIZE 41       // 40 char max + null terminator
+#define MAILBOXANY ((unsigned int) -1)  // "any sender"
+
+typedef struct msgSlot {
+    unsigned int sender;        // pID of the sender
+    signed char next;           // next slot in arrival order, -1 for the newest message
+    signed char prev;           // previous slot in arrival order, -1 for the oldest message
+    signed char bucketNext;     // next slot (in arrival order) whose sender falls in the same bucket
+    char msg[MAILBOXMSGSIZE];
+} msgSlot;
+
+typedef struct mailbox {
+    signed char first;          // oldest message, -1 if none
+    signed char last;           // newest message, -1 if none
+    unsigned char count;
+    unsigned char sizeClass;    // the block holds (1 << sizeClass) slots
+    signed char bucketFirst[MAILBOXBUCKETS];    // oldest message whose sender falls in each bucket
+    signed char bucketLast[MAILBOXBUCKETS];     // newest one
+    unsigned int freeSlots;     // bit i set: slots[i] is free
+    struct mailbox *nextFree;   // chains the blocks of the pool's free list
+    msgSlot slots[];            // (1 << sizeClass) of them
+} mailbox;
+
+// appends msg from sender to *box, taking a block from the pool if *box is NULL or full
+// returns the slot of the message, which it keeps until taken out, -1 if the mailbox is full or no block can
+// be allocated
+int mailboxPut(mailbox **box, unsigned int sender, const char *msg);
+
+// takes the oldest message from sender (MAILBOXANY: from anyone) out of *box
+// copies it into msg (MAILBOXMSGSIZE bytes) and its sender into *from
+// the block goes back to the pool once it is empty (*box is then NULL)
+// returns 0 on success, -1 if there is no such message
+int mailboxTake(mailbox **box, unsigned int sender, unsigned int *from, char *msg);
+
+// same with the message in the given slot (as returned by mailboxPut()), whatever its sender
+// returns 0 on success, -1 if the slot is empty
+int mailboxTakeSlot(mailbox **box, int slot, unsigned int *from, char *msg);
+
+// returns 1 if box holds a message from sender (MAILBOXANY: from anyone)
+int mailboxHas(const mailbox *box, unsigned int sender);
+
+// number of messages in box
+unsigned int mailboxCount(const mailbox *box);
+
+// copies every message of src (in order) into *dst, as long as *dst has room
+void mailboxCopy(mailbox **dst, const mailbox *src);
+
+// drops every message of *box and gives the block back to the pool
+void mailboxFree(mailbox **box);
+
+// frees the whole pool at once, together with every block still in use
+void mailboxRelease();
+
+// the pool of a simulation kept aside (see simSwap() in sim.h)
+typedef struct mailboxState mailboxState;
+
+// allocates the state of a simulation with an empty pool, NULL if it cannot be allocated
+mailboxState *mailboxStateCreate();
+
+// exchanges the pool of the thread with the one kept in state
+void mailboxSwap(mailboxState *state);
@@ -0,0 +1,121 @@
+//// pcb slab allocator
+//// See pcbslab.h for the interface
+////
+//// Created on: Oct 16, 2026
+
+#include <stdlib.h>
+
+#include "sim.h"
+#include "pcbslab.h"
+
+//-------------------------------------------------------------------------------------------------
+//---------------------------------- Data Structure Definitions -----------------------------------
+//-------------------------------------------------------------------------------------------------
+
+// one object slot: a pcb in use, or a link of the free list
+typedef union pcbSlot {
+    pcb proc;
+    union pcbSlot *nextFree;
+    char pad[(sizeof(pcb) + PCBCACHELINE - 1) / PCBCACHELINE * PCBCACHELINE];
+} pcbSlot;
+
+typedef struct pcbSlab {
+    pcbSlot slots[PCBSLABSIZE];     // first, so that they start on the slab's cache line
+    struct pcbSlab *next;           // previously allocated slab
+} pcbSlab;
+
+// the newest slab is the one being carved, older ones are full (their freed slots are in freeSlots)
+_Thread_local pcbSlab *slabs = NULL;
+_Thread_local int slabUsed = PCBSLABSIZE;
+_Thread_local pcbSlot *freeSlots = NULL;
+// number of slots that can be handed out without allocating a slab
+_Thread_local unsigned long numAvailable = 0;
+
+struct pcbSlabState {
+    pcbSlab *slabs;
+    int slabUsed;
+    pcbSlot *freeSlots;
+    unsigned long numAvailable;
+};
+
+//-------------------------------------------------------------------------------------------------
+//---------------------------------- Helper Functions ---------------------------------------------
+//-------------------------------------------------------------------------------------------------
+
+// pushes the unused remainder of the current slab into the free list, then starts a new slab
+// returns 0 on success, -1 if the slab cannot be allocated
+static int newSlab() {
+    // aligned_alloc() wants a size that is a multiple of the alignment
+    size_t size = (sizeof(pcbSlab) + PCBCACHELINE - 1) / PCBCACHELINE * PCBCACHELINE;
+    pcbSlab *slab = aligned_alloc(PCBCACHELINE, size);
+    if (!slab)
+        return -1;
+    while (slabs && slabUsed < PCBSLABSIZE) {
+        pcbSlot *slot = &slabs->slots[slabUsed++];
+        slot->nextFree = freeSlots;
+        freeSlots = slot;
+    }
+    slab->next = slabs;
+    slabs = slab;
+    slabUsed = 0;
+    numAvailable += PCBSLABSIZE;
+    return 0;
+}
+
+//-------------------------------------------------------------------------------------------------
+//---------------------------------- Implementation Definitions ----------------------------------
+//-------------------------------------------------------------------------------------------------
+
+struct pcb *pcbSlabAlloc() {
+    pcbSlot *slot;
+    if (freeSlots) {
+        slot = freeSlots;
+        freeSlots = slot->nextFree;
+    } else {
+        if (slabUsed == PCBSLABSIZE && newSlab())
+            return NULL;
+        slot = &slabs->slots[slabUsed++];
+    }
+    numAvailable--;
+    return &slot->proc;
+}
+
+void pcbSlabFree(struct pcb *proc) {
+    pcbSlot *slot = (pcbSlot *) proc;
+    slot->nextFree = freeSlots;
+    freeSlots = slot;
+    numAvailable++;
+}
+
+int pcbSlabReserve(unsigned long count) {
+    while (numAvailable < count) {
+        if (newSlab())
+            return -1;
+    }
+    return 0;
+}
+
+void pcbSlabRelease() {
+    while (slabs) {
+        pcbSlab *next = slabs->next;
+        free(slabs);
+        slabs = next;
+    }
+    slabUsed = PCBSLABSIZE;
+    freeSlots = NULL;
+    numAvailable = 0;
+}
+
+pcbSlabState *pcbSlabStateCreate() {
+    pcbSlabState *state = malloc(sizeof(pcbSlabState));
+    if (state)
+        *state = (pcbSlabState) {NULL, PCBSLABSIZE, NULL, 0};
+    return state;
+}
+
+void pcbSlabSwap(pcbSlabState *state) {
+    SIMSWAP(slabs, state->slabs);
+    SIMSWAP(slabUsed, state->slabUsed);
+    SIMSWAP(freeSlots, state->freeSlots);
+    SIMSWAP(numAvailable, state->numAvailable);
+}
@@ -0,0 +1,43 @@
+//// pcb slab allocator
+//// Every pcb comes from slabs of PCBSLABSIZE objects, carved out one after the other and never moved.
+//// A freed pcb is chained into a free list and handed out again before the slab is carved any further,
+//// so create/kill churn never reaches malloc()/free() once enough slabs exist.
+//// Slabs are aligned on a cache line and every object slot is rounded up to whole cache lines,
+//// so a pcb never shares a line with its neighbours.
+//// Slabs can be reserved ahead of time (see pcbSlabReserve()), and are only given back all at once
+//// when the simulation is torn down (see pcbSlabRelease()).
+////
+//// Created on: Oct 16, 2026
+#pragma once
+
+#define PCBCACHELINE 64
+
+#ifdef DEBUG
+#define PCBSLABSIZE 4       // small slabs, so that growing is exercised early
+#else
+#define PCBSLABSIZE 1024
+#endif
+
+struct pcb;
+
+// returns an uninitialized pcb, NULL if no slab can be allocated
+struct pcb *pcbSlabAlloc();
+
+// gives proc back to the free list
+void pcbSlabFree(struct pcb *proc);
+
+// allocates slabs until at least count pcbs can be handed out without allocating
+// returns 0 on success, -1 if a slab cannot be allocated
+int pcbSlabReserve(unsigned long count);
+
+// frees every slab at once, together with every pcb still in use
+void pcbSlabRelease();
+
+// the slabs of a simulation kept aside (see simSwap())
+typedef struct pcbSlabState pcbSlabState;
+
+// allocates the state of a simulation with no slab yet, NULL if it cannot be allocated
+pcbSlabState *pcbSlabStateCreate();
+
+// exchanges the slabs of the thread with the ones kept in state
+void pcbSlabSwap(pcbSlabState *state);
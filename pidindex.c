@@ -0,0 +1,99 @@
+//// PID index
+//// See pidindex.h for the interface
+////
+//// Created on: Oct 16, 2026
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "sim.h"
+#include "pidindex.h"
+
+//-------------------------------------------------------------------------------------------------
+//---------------------------------- Data Structure Definitions -----------------------------------
+//-------------------------------------------------------------------------------------------------
+
+#define PIDINDEXMINSIZE 1024
+#define PIDGENMASK ((1U << PIDGENBITS) - 1)
+#define PIDMAXSLOTS PIDNOSLOT
+
+#define PIDOF(slot, generation) (((generation) << PIDSLOTBITS) | (slot))
+
+//-------------------------------------------------------------------------------------------------
+//---------------------------------- Helper Functions ---------------------------------------------
+//-------------------------------------------------------------------------------------------------
+
+// returns a slot never used so far, PIDNOSLOT if there is none left or the table cannot grow
+static unsigned int freshSlot(pidIndex *index) {
+    if (index->slotsUsed == PIDMAXSLOTS)
+        return PIDNOSLOT;
+    if (index->slotsUsed == index->tableSize) {
+        unsigned int newSize = index->tableSize ? index->tableSize * 2 : PIDINDEXMINSIZE;
+        if (newSize > PIDMAXSLOTS)
+            newSize = PIDMAXSLOTS;
+        pidSlot *newTable = realloc(index->table, newSize * sizeof(pidSlot));
+        if (!newTable)
+            return PIDNOSLOT;
+        memset(newTable + index->tableSize, 0, (newSize - index->tableSize) * sizeof(pidSlot));
+        index->table = newTable;
+        index->tableSize = newSize;
+    }
+    return index->slotsUsed++;
+}
+
+// takes the oldest slot out of the free list
+static unsigned int reuseSlot(pidIndex *index) {
+    unsigned int slot = index->freeHead;
+    index->freeHead = index->table[slot].nextFree;
+    if (index->freeHead == PIDNOSLOT)
+        index->freeTail = PIDNOSLOT;
+    index->numFree--;
+    return slot;
+}
+
+//-------------------------------------------------------------------------------------------------
+//---------------------------------- Implementation Definitions ----------------------------------
+//-------------------------------------------------------------------------------------------------
+
+int pidIndexAdd(pidIndex *index, struct pcb *proc) {
+    unsigned int slot = PIDNOSLOT;
+    if (index->numFree <= PIDREUSEDELAY)
+        slot = freshSlot(index);
+    // out of fresh slots: fall back on the free list even if it is short
+    if (slot == PIDNOSLOT) {
+        if (!index->numFree)
+            return -1;
+        slot = reuseSlot(index);
+    }
+    index->table[slot].proc = proc;
+    proc->pID = PIDOF(slot, index->table[slot].generation);
+    return 0;
+}
+
+void pidIndexRemove(pidIndex *index, unsigned int pID) {
+    unsigned int slot = PIDSLOT(pID);
+    if (pidIndexFind(index, pID) == NULL)
+        return;
+    index->table[slot].proc = NULL;
+    index->table[slot].generation = (index->table[slot].generation + 1) & PIDGENMASK;
+    index->table[slot].nextFree = PIDNOSLOT;
+    if (index->freeTail != PIDNOSLOT)
+        index->table[index->freeTail].nextFree = slot;
+    else
+        index->freeHead = slot;
+    index->freeTail = slot;
+    index->numFree++;
+}
+
+struct pcb *pidIndexFind(const pidIndex *index, unsigned int pID) {
+    unsigned int slot = PIDSLOT(pID);
+    if (slot >= index->slotsUsed || index->table[slot].proc == NULL
+        || (pID >> PIDSLOTBITS) != index->table[slot].generation)
+        return NULL;
+    return index->table[slot].proc;
+}
+
+void pidIndexFree(pidIndex *index) {
+    free(index->table);
+    *index = (pidIndex) PIDINDEXEMPTY;
+}
@@ -0,0 +1,59 @@
+//// PID index
+//// Allocates the pIDs and maps a pID to its pcb in O(1), instead of searching every ready, semaphore and
+//// waiting queue in turn. The queue a process sits in is recorded in the pcb itself (see pcb.queue in sim.h).
+////
+//// A pID is made of a slot of the table (low PIDSLOTBITS bits) and the generation of that slot (above):
+//// the generation is bumped every time the slot is freed, so the pID of a dead process never finds the
+//// process that got its slot afterwards. Free slots are chained in FIFO order through the table, and are
+//// only reused once more than PIDREUSEDELAY of them are waiting: until then new slots are taken at the end
+//// of the table, which keeps pIDs sequential (0, 1, 2...) in short runs and delays the reuse of a slot.
+//// Allocation and release never scan the table. pIDs stay below 2^31 so that any of them can be typed back.
+//// The allocation order only depends on the sequence of additions and removals, so an index fed the same
+//// sequence hands out the same pIDs: the workload generator keeps one to know the pIDs of the processes it
+//// creates (see workload.c).
+////
+//// Created on: Oct 16, 2026
+#pragma once
+
+#define PIDSLOTBITS 22      // up to 2^22 - 1 processes alive at once
+#define PIDGENBITS 9        // a slot hands out the same pID again after 2^9 reuses
+#define PIDSLOT(pID) ((pID) & ((1U << PIDSLOTBITS) - 1))
+#define PIDNOSLOT ((1U << PIDSLOTBITS) - 1)    // the all-ones slot is never handed out, so no pID is MAILBOXANY
+#ifdef DEBUG
+#define PIDREUSEDELAY 4
+#else
+#define PIDREUSEDELAY 1024
+#endif
+
+struct pcb;
+
+typedef struct pidSlot {
+    struct pcb *proc;           // NULL if the slot is free
+    unsigned int generation;
+    unsigned int nextFree;      // next slot of the free list, PIDNOSLOT for the last one
+} pidSlot;
+
+typedef struct pidIndex {
+    pidSlot *table;
+    unsigned int tableSize;
+    unsigned int slotsUsed;     // slots ever handed out: [0, slotsUsed) are live or in the free list
+    unsigned int freeHead;      // oldest free slot
+    unsigned int freeTail;      // newest free slot
+    unsigned int numFree;
+} pidIndex;
+
+// an index without any pID handed out yet
+#define PIDINDEXEMPTY {NULL, 0, 0, PIDNOSLOT, PIDNOSLOT, 0}
+
+// assigns proc a free pID (proc->pID) and registers it under that pID
+// returns 0 on success, -1 if every pID is in use or the table cannot grow
+int pidIndexAdd(pidIndex *index, struct pcb *proc);
+
+// forgets the process with pID and frees its pID
+void pidIndexRemove(pidIndex *index, unsigned int pID);
+
+// returns the process with pID, NULL if there is no such process (or it died since)
+struct pcb *pidIndexFind(const pidIndex *index, unsigned int pID);
+
+// frees the table, pIDs start from 0 again
+void pidIndexFree(pidIndex *index);
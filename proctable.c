@@ -0,0 +1,340 @@
+//// Process table
+//// See proctable.h for the interface
+////
+//// Created on: Oct 16, 2026
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "sim.h"
+#include "proctable.h"
+
+#if MAXPRIORITIES > 255
+#error "the process table keeps priorities in one byte"
+#endif
+
+#if !defined(NOSIMD) && defined(__GNUC__) && defined(__x86_64__)
+#define PROCTABLESIMD
+#include <immintrin.h>
+#endif
+
+//-------------------------------------------------------------------------------------------------
+//---------------------------------- Data Structure Definitions -----------------------------------
+//-------------------------------------------------------------------------------------------------
+
+#define PROCTABLEMINSIZE 1024   // a multiple of PROCTABLEBLOCK
+#define PROCTABLEALIGN 32       // one AVX2 register
+#define PROCTABLECHUNK 64       // blocks matched per call of matchBlocks
+
+// one array per field, entry i of each belongs to slot i of the PID index
+_Thread_local uint32_t *tablePIDs = NULL;
+_Thread_local uint32_t *tableEpochs = NULL;       // pcb.epoch: the priority is 0 if it is not boostEpoch
+_Thread_local uint8_t *tableStates = NULL;        // PROCTABLEFREE if there is no process in the slot
+_Thread_local uint8_t *tablePriorities = NULL;
+_Thread_local uint8_t *tablePending = NULL;       // messages waiting to be received
+_Thread_local unsigned long tableCapacity = 0;
+_Thread_local unsigned long tableEnd = 0;         // entries past the last slot ever synced are all free
+
+// the scan picked (matchBlocks) depends on the CPU only, it is the thread's rather than a simulation's
+struct procTableState {
+    uint32_t *tablePIDs;
+    uint32_t *tableEpochs;
+    uint8_t *tableStates;
+    uint8_t *tablePriorities;
+    uint8_t *tablePending;
+    unsigned long tableCapacity;
+    unsigned long tableEnd;
+};
+
+// stores the matches of numBlocks blocks of PROCTABLEBLOCK entries from base into matches,
+// bit i of matches[b] set if entry base + b * PROCTABLEBLOCK + i matches. Returns the number of matches
+typedef unsigned long (*blockMatcher)(procField field, unsigned int value, unsigned long base, unsigned long numBlocks,
+                             uint32_t *matches);
+_Thread_local blockMatcher matchBlocks = NULL;    // picked on the first query
+
+//-------------------------------------------------------------------------------------------------
+//---------------------------------- Helper Functions ---------------------------------------------
+//-------------------------------------------------------------------------------------------------
+
+// moves *array into a new aligned array of newCap elements of elemSize, filling the new elements with fill
+static int growArray(void **array, size_t elemSize, int fill, unsigned long newCap) {
+    void *newArray = aligned_alloc(PROCTABLEALIGN, newCap * elemSize);
+    if (!newArray)
+        return -1;
+    if (*array)
+        memcpy(newArray, *array, tableCapacity * elemSize);
+    memset((char *) newArray + tableCapacity * elemSize, fill, (newCap - tableCapacity) * elemSize);
+    free(*array);
+    *array = newArray;
+    return 0;
+}
+
+// makes room for slot, returns 0 on success, -1 on failure
+static int growTable(unsigned long slot) {
+    unsigned long newCap = tableCapacity ? tableCapacity : PROCTABLEMINSIZE;
+    while (newCap <= slot)
+        newCap *= 2;
+    if (growArray((void **) &tablePIDs, sizeof(uint32_t), 0, newCap) ||
+        growArray((void **) &tableEpochs, sizeof(uint32_t), 0, newCap) ||
+        growArray((void **) &tableStates, sizeof(uint8_t), PROCTABLEFREE, newCap) ||
+        growArray((void **) &tablePriorities, sizeof(uint8_t), 0, newCap) ||
+        growArray((void **) &tablePending, sizeof(uint8_t), 0, newCap))
+        return -1;      // the arrays grown so far keep their content, tableCapacity still fits them all
+    tableCapacity = newCap;
+    return 0;
+}
+
+#ifndef PROCTABLESIMD
+
+// matches of the block from base, in plain C
+static uint32_t blockScalar(procField field, unsigned int value, unsigned long base) {
+    uint32_t matches = 0;
+    int i;
+    for (i = 0; i < PROCTABLEBLOCK; i++) {
+        unsigned long e = base + i;
+        if (tableStates[e] == PROCTABLEFREE)
+            continue;
+        switch (field) {
+            case PROCSTATE:
+                matches |= (uint32_t) (tableStates[e] == value) << i;
+                break;
+            case PROCPRIORITY:
+                matches |= (uint32_t) ((tableEpochs[e] == boostEpoch ? tablePriorities[e] : 0) == value) << i;
+                break;
+            case PROCPENDING:
+                matches |= (uint32_t) (tablePending[e] >= value) << i;
+                break;
+        }
+    }
+    return matches;
+}
+
+static unsigned long matchScalar(procField field, unsigned int value, unsigned long base, unsigned long numBlocks,
+                                 uint32_t *matches) {
+    unsigned long b, count = 0;
+    for (b = 0; b < numBlocks; b++) {
+        matches[b] = blockScalar(field, value, base + b * PROCTABLEBLOCK);
+        count += __builtin_popcount(matches[b]);
+    }
+    return count;
+}
+
+#else
+
+// matches of the block from base, with SSE2 (always there on x86-64): 16 bytes or 4 epochs per register
+static inline uint32_t blockSSE2(procField field, unsigned int value, unsigned long base) {
+    __m128i free8 = _mm_set1_epi8((char) PROCTABLEFREE);
+    __m128i lo = _mm_load_si128((const __m128i *) (tableStates + base));
+    __m128i hi = _mm_load_si128((const __m128i *) (tableStates + base + 16));
+    uint32_t live = ~((uint32_t) _mm_movemask_epi8(_mm_cmpeq_epi8(lo, free8)) |
+                      (uint32_t) _mm_movemask_epi8(_mm_cmpeq_epi8(hi, free8)) << 16);
+    __m128i value8 = _mm_set1_epi8((char) value);
+    uint32_t matches = 0;
+    int i;
+
+    switch (field) {
+        case PROCSTATE:
+            return (uint32_t) _mm_movemask_epi8(_mm_cmpeq_epi8(lo, value8)) |
+                   (uint32_t) _mm_movemask_epi8(_mm_cmpeq_epi8(hi, value8)) << 16;
+        case PROCPENDING:
+            // x >= value <=> max(x, value) == x
+            lo = _mm_load_si128((const __m128i *) (tablePending + base));
+            hi = _mm_load_si128((const __m128i *) (tablePending + base + 16));
+            matches = (uint32_t) _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_max_epu8(lo, value8), lo)) |
+                      (uint32_t) _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_max_epu8(hi, value8), hi)) << 16;
+            return matches & live;
+        case PROCPRIORITY: {
+            // a priority is value if its epoch is current, else it is 0 (boosted since)
+            __m128i zero = _mm_setzero_si128();
+            __m128i epoch = _mm_set1_epi32((int) boostEpoch);
+            __m128i value32 = _mm_set1_epi32((int) value);
+            __m128i stale = value ? zero : _mm_set1_epi32(-1);
+            for (i = 0; i < PROCTABLEBLOCK; i += 16) {
+                __m128i prio8 = _mm_load_si128((const __m128i *) (tablePriorities + base + i));
+                __m128i prio16[2] = {_mm_unpacklo_epi8(prio8, zero), _mm_unpackhi_epi8(prio8, zero)};
+                int j;
+                for (j = 0; j < 4; j++) {
+                    __m128i prio = j & 1 ? _mm_unpackhi_epi16(prio16[j / 2], zero)
+                                         : _mm_unpacklo_epi16(prio16[j / 2], zero);
+                    __m128i cur = _mm_cmpeq_epi32(
+                            _mm_load_si128((const __m128i *) (tableEpochs + base + i + 4 * j)), epoch);
+                    __m128i hit = _mm_or_si128(_mm_and_si128(cur, _mm_cmpeq_epi32(prio, value32)),
+                                               _mm_andnot_si128(cur, stale));
+                    matches |= (uint32_t) _mm_movemask_ps(_mm_castsi128_ps(hit)) << (i + 4 * j);
+                }
+            }
+            return matches & live;
+        }
+    }
+    return 0;
+}
+
+// matches of the block from base, with AVX2: a whole block of bytes, or 8 epochs, per register
+__attribute__((target("avx2")))
+static inline uint32_t blockAVX2(procField field, unsigned int value, unsigned long base) {
+    __m256i states = _mm256_load_si256((const __m256i *) (tableStates + base));
+    uint32_t live = ~(uint32_t) _mm256_movemask_epi8(_mm256_cmpeq_epi8(states, _mm256_set1_epi8((char) PROCTABLEFREE)));
+    __m256i value8 = _mm256_set1_epi8((char) value);
+    uint32_t matches = 0;
+    int i;
+
+    switch (field) {
+        case PROCSTATE:
+            return (uint32_t) _mm256_movemask_epi8(_mm256_cmpeq_epi8(states, value8));
+        case PROCPENDING: {
+            __m256i pending = _mm256_load_si256((const __m256i *) (tablePending + base));
+            matches = (uint32_t) _mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_max_epu8(pending, value8), pending));
+            return matches & live;
+        }
+        case PROCPRIORITY: {
+            __m256i epoch = _mm256_set1_epi32((int) boostEpoch);
+            __m256i value32 = _mm256_set1_epi32((int) value);
+            __m256i stale = value ? _mm256_setzero_si256() : _mm256_set1_epi32(-1);
+            for (i = 0; i < PROCTABLEBLOCK; i += 8) {
+                __m256i prio = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i *) (tablePriorities + base + i)));
+                __m256i cur = _mm256_cmpeq_epi32(_mm256_load_si256((const __m256i *) (tableEpochs + base + i)), epoch);
+                __m256i hit = _mm256_or_si256(_mm256_and_si256(cur, _mm256_cmpeq_epi32(prio, value32)),
+                                              _mm256_andnot_si256(cur, stale));
+                matches |= (uint32_t) _mm256_movemask_ps(_mm256_castsi256_ps(hit)) << i;
+            }
+            return matches & live;
+        }
+    }
+    return 0;
+}
+
+// every CPU with AVX2 has POPCNT too
+__attribute__((target("avx2,popcnt")))
+static unsigned long matchAVX2(procField field, unsigned int value, unsigned long base, unsigned long numBlocks,
+                               uint32_t *matches) {
+    unsigned long b, count = 0;
+    for (b = 0; b < numBlocks; b++) {
+        matches[b] = blockAVX2(field, value, base + b * PROCTABLEBLOCK);
+        count += __builtin_popcount(matches[b]);
+    }
+    return count;
+}
+
+static unsigned long matchSSE2(procField field, unsigned int value, unsigned long base, unsigned long numBlocks,
+                               uint32_t *matches) {
+    unsigned long b, count = 0;
+    for (b = 0; b < numBlocks; b++) {
+        matches[b] = blockSSE2(field, value, base + b * PROCTABLEBLOCK);
+        count += __builtin_popcount(matches[b]);
+    }
+    return count;
+}
+
+#endif
+
+static void pickMatcher() {
+#ifdef PROCTABLESIMD
+    __builtin_cpu_init();
+    matchBlocks = __builtin_cpu_supports("avx2") ? matchAVX2 : matchSSE2;
+#else
+    matchBlocks = matchScalar;
+#endif
+}
+
+// returns 0 if no entry can match field == value, so that the byte-wide scans never see a wrapped value
+static int canMatch(procField field, unsigned int value) {
+    if (!tableEnd)
+        return 0;
+    switch (field) {
+        case PROCSTATE:
+            return value < PROCTABLEFREE;
+        case PROCPRIORITY:
+            return value < numPriorities;
+        case PROCPENDING:
+            return value <= UINT8_MAX;
+    }
+    return 0;
+}
+
+//-------------------------------------------------------------------------------------------------
+//---------------------------------- Implementation Definitions ----------------------------------
+//-------------------------------------------------------------------------------------------------
+
+int procTableSync(const struct pcb *proc) {
+    unsigned long slot = PIDSLOT(proc->pID);
+    if (slot >= tableCapacity && growTable(slot))
+        return -1;
+    tablePIDs[slot] = proc->pID;
+    tableEpochs[slot] = proc->epoch;
+    tableStates[slot] = (uint8_t) proc->state;
+    tablePriorities[slot] = (uint8_t) proc->priority;
+    tablePending[slot] = (uint8_t) mailboxCount(proc->inbox);
+    if (slot >= tableEnd)
+        tableEnd = slot + 1;
+    return 0;
+}
+
+void procTableRemove(unsigned int pID) {
+    unsigned long slot = PIDSLOT(pID);
+    if (slot < tableCapacity && tablePIDs[slot] == pID)
+        tableStates[slot] = PROCTABLEFREE;
+}
+
+// number of blocks from base up to tableEnd, at most PROCTABLECHUNK
+static unsigned long chunkBlocks(unsigned long base) {
+    unsigned long numBlocks = (tableEnd - base + PROCTABLEBLOCK - 1) / PROCTABLEBLOCK;
+    return numBlocks < PROCTABLECHUNK ? numBlocks : PROCTABLECHUNK;
+}
+
+unsigned long procTableCount(procField field, unsigned int value) {
+    uint32_t matches[PROCTABLECHUNK];
+    unsigned long base, count = 0;
+    if (!canMatch(field, value))
+        return 0;
+    if (!matchBlocks)
+        pickMatcher();
+    for (base = 0; base < tableEnd; base += PROCTABLECHUNK * PROCTABLEBLOCK)
+        count += matchBlocks(field, value, base, chunkBlocks(base), matches);
+    return count;
+}
+
+unsigned long procTableFilter(procField field, unsigned int value, unsigned int *pIDs, unsigned long max) {
+    uint32_t matches[PROCTABLECHUNK];
+    unsigned long base, b, found = 0;
+    if (!canMatch(field, value))
+        return 0;
+    if (!matchBlocks)
+        pickMatcher();
+    for (base = 0; base < tableEnd && found < max; base += PROCTABLECHUNK * PROCTABLEBLOCK) {
+        unsigned long numBlocks = chunkBlocks(base);
+        matchBlocks(field, value, base, numBlocks, matches);
+        for (b = 0; b < numBlocks && found < max; b++) {
+            while (matches[b] && found < max) {
+                pIDs[found++] = tablePIDs[base + b * PROCTABLEBLOCK + __builtin_ctz(matches[b])];
+                matches[b] &= matches[b] - 1;
+            }
+        }
+    }
+    return found;
+}
+
+void procTableFree() {
+    free(tablePIDs);
+    free(tableEpochs);
+    free(tableStates);
+    free(tablePriorities);
+    free(tablePending);
+    tablePIDs = tableEpochs = NULL;
+    tableStates = tablePriorities = tablePending = NULL;
+    tableCapacity = tableEnd = 0;
+}
+
+procTableState *procTableStateCreate() {
+    return calloc(1, sizeof(procTableState));
+}
+
+void procTableSwap(procTableState *state) {
+    SIMSWAP(tablePIDs, state->tablePIDs);
+    SIMSWAP(tableEpochs, state->tableEpochs);
+    SIMSWAP(tableStates, state->tableStates);
+    SIMSWAP(tablePriorities, state->tablePriorities);
+    SIMSWAP(tablePending, state->tablePending);
+    SIMSWAP(tableCapacity, state->tableCapacity);
+    SIMSWAP(tableEnd, state->tableEnd);
+}
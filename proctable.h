@@ -0,0 +1,50 @@
+//// Process table
+//// A struct-of-arrays shadow of the pcbs, for bulk questions such as "how many processes are BLOCKED",
+//// "which ones are at priority 2" or "which ones have a message waiting", answered without walking any
+//// queue nor touching any pcb. Entry i mirrors the process in slot i of the PID index (see pidindex.h),
+//// and each field lives in its own packed array, so a query streams through one or two arrays only.
+//// sim.c copies a pcb into its entry (procTableSync()) every time its state, priority or mailbox changes.
+////
+//// The scans work on blocks of PROCTABLEBLOCK entries at a time: with AVX2 when the CPU has it (checked
+//// at run time), else with SSE2, else with plain C. Building with -DNOSIMD keeps the plain C version only.
+////
+//// Created on: Oct 16, 2026
+#pragma once
+
+#define PROCTABLEBLOCK 32       // entries per scanned block, the arrays are sized in whole blocks
+#define PROCTABLEFREE 0xFF      // state of an entry with no process
+
+struct pcb;
+
+// the fields a query can select on
+typedef enum {
+    PROCSTATE = 0,      // processes whose state is value
+    PROCPRIORITY,       // processes at priority value (priority boosts included, see syncProc())
+    PROCPENDING         // processes with at least value messages waiting to be received
+} procField;
+
+// copies the state, priority and mailbox size of proc into its entry
+// returns 0 on success, -1 if the table cannot grow (the entry is then missing from the queries)
+int procTableSync(const struct pcb *proc);
+
+// empties the entry of the process with pID
+void procTableRemove(unsigned int pID);
+
+// number of processes matching field == value (see procField), "init" included
+unsigned long procTableCount(procField field, unsigned int value);
+
+// stores the pIDs of up to max processes matching field == value into pIDs, in slot order
+// returns the number of pIDs stored
+unsigned long procTableFilter(procField field, unsigned int value, unsigned int *pIDs, unsigned long max);
+
+// frees the table
+void procTableFree();
+
+// the table of a simulation kept aside (see simSwap() in sim.h)
+typedef struct procTableState procTableState;
+
+// allocates the state of a simulation with an empty table, NULL if it cannot be allocated
+procTableState *procTableStateCreate();
+
+// exchanges the table of the thread with the one kept in state
+void procTableSwap(procTableState *state);
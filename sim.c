@@ -0,0 +1,1386 @@
+//// This project is created to fulfill CMPT300 Assignment 3 requirements
+//// It consists of an OS Process Scheduling Simulation with Priority Queue and Round Robin scheme
+////
+//// Design decisions:
+//// 1)
+//// The Priority Queue has been chosen to implement "Multilevel Feedback Queue" as its Policy
+//// Specifically, every job will enter the top priority queue at start
+//// They will degrade a priority after each burst (staying at the lowest level once they reach it)
+//// There are 3 levels by default, any number up to MAXPRIORITIES can be chosen at start time
+//// If a process was blocked either by semaphore or by waiting to recv/for reply, it will not suffer priority degradation.
+//// Since the user is managing the concept 'time' (in the Q command), the age of a process is not easily determined
+//// thus to prevent starvation, a process will never be upgrade back its priority,
+//// unless a periodic priority boost is enabled (--boost): every N quanta, every process goes back to the top priority
+//// This policy is the default of several (see schedPolicy), chosen at start time: plain round robin, first come
+//// first served and completely fair scheduling (see cfs.h) can be run instead, on the same command set and traces
+//// Real-time tasks (X command) are scheduled ahead of any of them, earliest deadline first (see edf.h)
+//// Several CPUs can be simulated (--cpus), each running a process out of a ready set of its own. A CPU whose
+//// ready set is empty steals a ready process from another one, and the U command picks the CPU the other
+//// commands act on (see cpu in sim.h)
+//// 2)
+//// The send/receive/reply mechanism has been chosen to be implemented as such:
+//// After a process has sent a message to another process, it will be waiting for REPLY from ANY process to unblock itself
+//// During this time, other processes are allowed to send to it (and this other process will be blocked as a result),
+//// every message sent or replied to a process joins its mailbox (up to MAILBOXSIZE, see mailbox.h) instead of
+//// overwriting the previous one. When the process runs again it receives the reply that woke it up, the other
+//// messages stay in the mailbox for later receives (the user can see them with "totalinfo_T" command).
+//// A receive takes the oldest message, or the oldest one from a given sender (R [pID]), and blocks if there is none.
+//// this leads to the slight flaw that the user will potentially not get a prompt to REPLY a process in order to unblock it
+//// instead, the user will have to rely on using "totalinfo_T" command to see what is currently block and needs to be replied.
+////
+//// Additionally, sending and replying (when unblocked of course) to a process itself is allowed.
+//// replying to a process that is not blocked and awaiting for a reply is allowed.
+////
+////
+//// Created on: Jul 7, 2017
+//// Last Modified: Jul 12, 2017
+//// Author: Yu Xuan (Shawn) Wang
+//// Email: yxwang@sfu.ca
+//// Student #: 301227972
+
+
+#include "sim.h"
+
+
+// |-------------------------------------------------------------------------|
+// |                    Global State                                         |
+// |-------------------------------------------------------------------------|
+// a translation table for the enums
+// solution to print enums, as seen here: https://stackoverflow.com/a/2161797
+char *enumStrings[] = {"READY", "RUNNING", "BLOCKED"};
+
+_Thread_local unsigned int numPriorities = DEFAULTPRIORITIES;
+_Thread_local unsigned int numCpus = 1;
+_Thread_local cpu *cpus = NULL;       // the simulated CPUs, numCpus of them
+_Thread_local cpu *curCpu = NULL;     // the CPU the commands act on (see cpu_U())
+// bitmap of the CPUs, bit c is set while cpus[c] has a ready process, so that a CPU looking for one to steal
+// finds it with a find-first-set per word instead of looking at every CPU
+_Thread_local unsigned long long stealable[CPUWORDS];
+_Thread_local unsigned int numIdle;   // CPUs running proc_init, which is RUNNING as long as there is one
+_Thread_local unsigned int boostInterval = 0;     // quanta between two priority boosts, 0 if there is none
+_Thread_local unsigned int quantaSinceBoost;
+_Thread_local unsigned int boostEpoch;            // number of priority boosts so far
+_Thread_local sem *sems = NULL;       // semaphores available for user controlling processes, indexed by semID
+_Thread_local unsigned int semTableSize = 0;
+_Thread_local procQueue waitingReply;    // used for sender blocked until reply
+_Thread_local procQueue waitingRcv;      // used for rcvers blocked until received
+
+_Thread_local unsigned int numProcs;     // number of processes besides proc_init (queued, blocked or running)
+_Thread_local pidIndex procIndex = PIDINDEXEMPTY;     // the pIDs of the processes and their pcbs
+_Thread_local unsigned int run;      // global variable to control whether the simulation is shutting down
+_Thread_local pcb *proc_init;     // special process to be put when nothing else is running
+_Thread_local pcb *runningProc;       // ptr to the process that is currently running on the current CPU
+_Thread_local unsigned int quiet = 0;     // set to suppress every report, the event log (if open) is then the only output
+_Thread_local FILE *reportFile = NULL;    // where the reports go, stdout if NULL
+_Thread_local cmdOutcome outcome;
+
+
+// |-------------------------------------------------------------------------|
+// |                          Helper Functions                               |
+// |-------------------------------------------------------------------------|
+
+// print the process specified
+// return 0 upon success, 1 upon failure
+int printProc(pcb *procFound) {
+    if (procFound) {
+        syncProc(procFound);
+        if (procFound == proc_init)
+            REPORT("The special process \"init\" with pID=%u, has:\n", procFound->pID);
+        else
+            REPORT("The process with pID=%u, has:\n", procFound->pID);
+        REPORT("\tPriority: %u (0 being top, %u being lowest)\n", procFound->priority, numPriorities - 1);
+        if (numCpus > 1 && procFound != proc_init)
+            REPORT("\tCPU: #%u\n", procFound->cpuID);
+        if (EDFTASK(procFound))
+            REPORT("\tReal-time task: period %u, deadline %u, budget %u; current job released at tick %lu, due at tick %lu, %u quanta used\n",
+                   procFound->rt.period, procFound->rt.deadline, procFound->rt.budget, procFound->rt.release,
+                   procFound->rt.due, procFound->rt.used);
+        REPORT("\tState: %s", enumStrings[procFound->state]);
+        if(procFound->state==BLOCKED)
+        	REPORT_PUTS("\t(Note: A newly unblocked process that hasn't got a turn in the CPU will also be represented by a BLOCKING state)\n");
+        else
+        	REPORT_PUTS("");
+        if (procFound->inbox) {
+            mailbox *inbox = procFound->inbox;
+            int i;
+            for (i = inbox->first; i >= 0; i = inbox->slots[i].next)
+                REPORT("\tThis process has message \"%s\" from %u waiting to be received.\n", inbox->slots[i].msg,
+                       inbox->slots[i].sender);
+        } else
+            REPORT_PUTS("\tThis process has no message waiting to be received.\n");
+        return 0;
+    } else
+        return 1;
+}
+
+// Short version of printProc() for release ver.
+// it only reads the process: a priority pending a boost is shown as it will be once synced (see syncProc())
+int oneLinePrintProc(pcb * procPrint){
+	if(!procPrint)
+		return 1;
+	unsigned int priority = procPrint->epoch == boostEpoch ? procPrint->priority : 0;
+	if(procPrint==proc_init)
+		REPORT("Special \"Init\" Process with pID#%u and priority #%u\n",procPrint->pID, priority);
+	else
+		REPORT("Process with pID#%u and priority #%u\n",procPrint->pID, priority);
+	return 0;
+}
+
+// takes the process at the tail of queue (the next one in FIFO order) out of it
+// returns NULL if queue is empty
+pcb *dequeueProc(procQueue *queue) {
+    pcb *aProc = procQueuePop(queue);
+    if (aProc)
+        syncProc(aProc);
+    return aProc;
+}
+
+// sets aProc running on aCpu, runningProc follows the current CPU
+// the state of aProc is left to the caller, that of proc_init follows the number of idle CPUs
+static void setRunning(cpu *aCpu, pcb *aProc) {
+    if (aCpu->running == proc_init)
+        numIdle--;
+    if (aProc == proc_init)
+        numIdle++;
+    aCpu->running = aProc;
+    if (aCpu == curCpu)
+        runningProc = aProc;
+    if ((proc_init->state == RUNNING) != (numIdle > 0)) {
+        proc_init->state = numIdle ? RUNNING : READY;
+        procTableSync(proc_init);
+    }
+}
+
+// counts a process into the ready set of aCpu, which other CPUs can then steal from
+static void readyAdd(cpu *aCpu) {
+    if (!aCpu->numReady++)
+        stealable[aCpu->id / 64] |= 1ULL << (aCpu->id % 64);
+}
+
+// counts a process out of the ready set of aCpu
+static void readyTake(cpu *aCpu) {
+    if (!--aCpu->numReady)
+        stealable[aCpu->id / 64] &= ~(1ULL << (aCpu->id % 64));
+}
+
+// returns 1 if aProc sits in one of the ready queues (of its CPU)
+static int isReadyQueue(pcb *aProc) {
+    procQueue *readyQ = cpus[aProc->cpuID].priorityQ;
+    return aProc->queue >= readyQ && aProc->queue < readyQ + numPriorities;
+}
+
+// takes aProc out of whichever queue holds it (nothing to do if it sits in none)
+void unqueueProc(pcb *aProc) {
+    syncProc(aProc);
+    if (aProc->queue) {
+        if (isReadyQueue(aProc))
+            readyTake(&cpus[aProc->cpuID]);
+        procQueueRemove(aProc);
+    } else if (EDFTASK(aProc))
+        edfRemove(aProc);
+    else if (policy->remove(aProc))
+        readyTake(&cpus[aProc->cpuID]);
+}
+
+// the running process aProc is about to block, its scheduling class is told
+static void classOnBlock(pcb *aProc) {
+    if (!EDFTASK(aProc))
+        policy->onBlock(aProc);
+}
+
+// the blocked process aProc is about to be readied, its scheduling class is told
+static void classOnUnblock(pcb *aProc) {
+    if (!EDFTASK(aProc))
+        policy->onUnblock(aProc);
+}
+
+// takes the next process out of the top non-empty ready queue of aCpu, NULL if they are all empty
+static pcb *dequeueReady(cpu *aCpu) {
+    int w;
+    for (w = 0; w < LEVELWORDS; w++) {
+        while (aCpu->readyLevels[w]) {
+            unsigned int level = w * 64 + __builtin_ctzll(aCpu->readyLevels[w]);
+            pcb *aProc = dequeueProc(&aCpu->priorityQ[level]);
+            if (!aCpu->priorityQ[level].count)
+                aCpu->readyLevels[w] &= ~(1ULL << (level % 64));
+            if (aProc)
+                return aProc;
+        }
+    }
+    return NULL;
+}
+
+// brings the priority of aProc, and its queue if it is ready, up to date with the boosts it missed
+// a boost splices whole queues without touching their pcbs (see boostPriorities()), so a pcb stamped
+// with an older epoch is at the top priority now, and sits in priorityQ[0] of its CPU if it sits in a ready queue
+// every path reading the priority or the queue of a process that may have missed a boost goes through here
+void syncProc(pcb *aProc) {
+    if (aProc->epoch != boostEpoch) {
+        aProc->epoch = boostEpoch;
+        aProc->priority = 0;
+        if (isReadyQueue(aProc))
+            aProc->queue = &cpus[aProc->cpuID].priorityQ[0];
+        procTableSync(aProc);
+    }
+}
+
+// moves every process back to the top priority
+// each lower ready queue of a CPU is spliced whole behind its priorityQ[0], keeping the FIFO order of the levels,
+// and the pcbs are only fixed up when next used (see syncProc()), so the cost does not depend on the
+// number of processes
+void boostPriorities() {
+    unsigned int c, level;
+
+    for (c = 0; c < numCpus; c++) {
+        cpu *aCpu = &cpus[c];
+        procQueue *top = &aCpu->priorityQ[0];
+        for (level = 1; level < numPriorities; level++)
+            procQueueSplice(top, &aCpu->priorityQ[level]);
+        memset(aCpu->readyLevels, 0, sizeof aCpu->readyLevels);
+        if (top->count)
+            aCpu->readyLevels[0] = 1;
+    }
+    boostEpoch++;
+    quantaSinceBoost = 0;
+    REPORT_PUTS("Priority boost: every process is back at priority #0.");
+    EVLOG(evlogBoost(runningProc->pID));
+}
+
+// returns 1 if there is no more process besides proc_init
+// else return 0
+int thereIsNoProc() {
+    return numProcs == 0;
+}
+
+// returns the number of processes besides proc_init (queued, blocked or running)
+// they are counted as they are created and deleted, so no queue (nor semaphore) is looked at
+unsigned int countProcs() {
+    return numProcs;
+}
+
+// returns the semaphore semID, NULL if it is not initialized
+static sem *findSem(unsigned int semID) {
+    return semID < semTableSize && sems[semID].inUse ? &sems[semID] : NULL;
+}
+
+// hands the process to the ready set of its CPU, kept by the scheduling policy, or to the real-time one
+// the queues are intrusive (see procQueue) and never full, so this cannot fail
+// returns 0 upon success
+int enqueueProc(pcb *aProc) {
+    // the process table gets the new state and priority, proc_init's included
+    procTableSync(aProc);
+    // reject proc_init but DO NOT toss an errors
+    if (proc_init == aProc)
+        return 0;
+    // the process is ready from now on
+    statsOnReady(&aProc->stats);
+    if (EDFTASK(aProc))
+        edfEnqueue(aProc);
+    else {
+        cpu *aCpu = &cpus[aProc->cpuID];
+        policy->enqueue(aCpu, aProc);
+        readyAdd(aCpu);
+    }
+    return 0;
+}
+
+// creates a new process initialized the highest priority, as multi-level feedback queue dictates,
+// on the current CPU
+// returns NULL if no pcb, no pID or no process table entry can be allocated
+pcb *createProc() {
+    pcb *newProc = pcbSlabAlloc();
+    if (!newProc)
+        return NULL;
+    // the pID is never the one of a live process, see pidindex.h
+    if (pidIndexAdd(&procIndex, newProc)) {
+        pcbSlabFree(newProc);
+        return NULL;
+    }
+    newProc->priority = 0;
+    newProc->state = READY;
+    newProc->inbox = NULL;
+    newProc->rcvFrom = MAILBOXANY;
+    newProc->wakeSlot = -1;
+    newProc->qPrev = newProc->qNext = NULL;
+    newProc->queue = NULL;
+    newProc->epoch = boostEpoch;
+    newProc->rb = (cfsNode) {NULL, NULL, NULL, 0, 0};
+    newProc->vruntime = 0;
+    newProc->rt = (edfTask) {0, 0, 0, 0, 0, 0, EDFNOHEAP, 0, 0};
+    newProc->cpuID = curCpu->id;
+    if (procTableSync(newProc)) {
+        pidIndexRemove(&procIndex, newProc->pID);
+        pcbSlabFree(newProc);
+        return NULL;
+    }
+    statsOnCreate(&newProc->stats);
+    return newProc;
+}
+
+// takes a ready process of another CPU for thief, whose own ready set is empty: the next one to run on the
+// first CPU with a ready process after thief, in circular order, so that the thieves spread over the loaded
+// CPUs. Those CPUs are found through the stealable bitmap, a word per 64 CPUs, and never by looking at each CPU
+// returns NULL if no other CPU has a ready process
+static pcb *stealProc(cpu *thief) {
+    unsigned int numWords = (numCpus + 63) / 64;
+    unsigned int start = thief->id + 1 < numCpus ? thief->id + 1 : 0;
+    unsigned int i;
+
+    thief->stats.stealTries++;
+    for (i = 0; i <= numWords; i++) {
+        unsigned int w = (start / 64 + i) % numWords;
+        unsigned long long bits = stealable[w];
+        // the word of start is looked at from start on first, and below start last
+        if (i == 0)
+            bits &= ~0ULL << (start % 64);
+        else if (i == numWords)
+            bits &= ~(~0ULL << (start % 64));
+        if (bits) {
+            cpu *victim = &cpus[w * 64 + __builtin_ctzll(bits)];
+            pcb *aProc = policy->pickNext(victim);
+            readyTake(victim);
+            policy->onMigrate(aProc, victim, thief);
+            aProc->cpuID = thief->id;
+            EVLOG(evlogMove(EV_STEAL, aProc->pID, victim->id, thief->id));
+            victim->stats.stolen++;
+            thief->stats.steals++;
+            return aProc;
+        }
+    }
+    return NULL;
+}
+
+// Take the ready real-time task with the earliest deadline, else the next process of the ready set of aCpu chosen
+// by the scheduling policy, else one stolen from another CPU, and set it to run on aCpu. proc_init runs if there
+// is none
+static void dispatch(cpu *aCpu) {
+    pcb *returnPcb = edfPickNext();
+    if (!returnPcb && (returnPcb = policy->pickNext(aCpu)))
+        readyTake(aCpu);
+    if (!returnPcb && numCpus > 1)
+        returnPcb = stealProc(aCpu);
+
+    if (returnPcb) {
+        // only a real-time task changes CPU here, a stolen process was moved already
+        if (returnPcb->cpuID != aCpu->id) {
+            EVLOG(evlogMove(EV_MIGRATE, returnPcb->pID, returnPcb->cpuID, aCpu->id));
+            aCpu->stats.rtMoves++;
+        }
+        returnPcb->cpuID = aCpu->id;
+        setRunning(aCpu, returnPcb);
+    } else {    //all the queues are empty, make proc_init the running process
+        setRunning(aCpu, proc_init);
+    }
+    STATSTICK();
+    aCpu->stats.dispatches++;
+    statsOnDispatch(&aCpu->running->stats);
+    EVLOG(evlogDispatch(aCpu->running->pID, aCpu->running->priority, aCpu->id));
+    if (numCpus > 1)
+        REPORT("\nThe process now running on CPU #%u is:\n", aCpu->id);
+    else
+        REPORT_PUTS("\nThe process now running is:");
+#ifdef DEBUG
+    printProc(aCpu->running);
+#endif
+#ifndef DEBUG
+    oneLinePrintProc(aCpu->running);
+#endif
+    // if the non-proc_init process has state BLOCKED, it was just awakened from waitingForReply or waitingForRcv
+    // print and take the message that woke it up out of its inbox
+    if(returnPcb && returnPcb->state==BLOCKED){
+        char msg[MAILBOXMSGSIZE];
+        unsigned int from;
+        if (!mailboxTakeSlot(&returnPcb->inbox, returnPcb->wakeSlot, &from, msg)) {
+            REPORT("The process received a new message from pID#%u:\n\"%s\"\n", from, msg);
+            EVLOG(evlogReceive(returnPcb->pID, from, msg));
+        }
+        returnPcb->rcvFrom = MAILBOXANY;
+        returnPcb->wakeSlot = -1;
+    }
+    if (returnPcb) {
+        returnPcb->state = RUNNING;
+        procTableSync(returnPcb);
+    }
+}
+
+// runs the next process on the current CPU (see dispatch())
+void runNextProc() {
+    dispatch(curCpu);
+}
+
+
+// this function handles the killing of a specific process
+// This function assumes that process has already probably dequeued from whichever data structure
+// This function will also load the next available process on the CPU running the killed process, if any
+// returns 0 on success, -1 if there is no process or it is "init" while other processes are alive
+int deleteProc(pcb *delProc) {
+    if (delProc) {
+        if (delProc == proc_init) {
+            if (thereIsNoProc()) {  // time to terminate
+                EVLOG(evlogKill(delProc->pID));
+                pidIndexRemove(&procIndex, delProc->pID);
+                procTableRemove(delProc->pID);
+                REPORT_PUTS("The special \"init\" process has been killed!\nIts properties were:\n");
+                printProc(delProc);
+                pcbSlabFree(delProc);
+                REPORT_PUTS("\nGoodbye\n");
+                run = 0;
+            } else {
+                REPORT("You have attempted to kill the special \"init\" process!\nThis is not allowed when there are still other processes running!\n");
+                return -1;
+            }
+        } else {
+            EVLOG(evlogKill(delProc->pID));
+            statsOnExit(&delProc->stats, delProc->pID, delProc->priority);
+            if (EDFTASK(delProc)) {
+                // a job abandoned past its deadline is a miss all the same
+                int late;
+                long lateness = edfRetire(delProc, &late);
+                if (late)
+                    statsOnJob(lateness);
+            }
+            numProcs--;
+            pidIndexRemove(&procIndex, delProc->pID);
+            procTableRemove(delProc->pID);
+            cpu *onCpu = &cpus[delProc->cpuID];
+            if (delProc == onCpu->running) {
+                if (onCpu == curCpu)
+                    REPORT_PUTS("The currently running process has been killed. Its properties were:\n");
+                else
+                    REPORT("The process running on CPU #%u has been killed. Its properties were:\n", onCpu->id);
+                printProc(delProc);
+                dispatch(onCpu);
+                mailboxFree(&delProc->inbox);
+                pcbSlabFree(delProc);
+            } else {
+                REPORT("The process with pID#%u has been killed. Its properties were:\n", delProc->pID);
+                printProc(delProc);
+                mailboxFree(&delProc->inbox);
+                pcbSlabFree(delProc);
+            }
+        }
+    }
+#ifdef DEBUG
+    else
+       fprintf(stderr,"Warning: Empty pcb *delProc passed int deleteProc!\n");
+#endif
+    return delProc ? 0 : -1;
+}
+
+// |-------------------------------------------------------------------------|
+// |                          Scheduling Policies                            |
+// |-------------------------------------------------------------------------|
+// every policy but cfs keeps the ready processes of a CPU in its intrusive ready queues (cpu.priorityQ), which
+// unqueueProc() takes a process out of whatever the policy
+
+// hook with nothing to do
+static void policyNoHook(pcb *aProc) {
+}
+
+// remove hook of the policies using the ready queues
+static int policyNotQueued(pcb *aProc) {
+    return 0;
+}
+
+// migrate hook with nothing to do: the priority of a process means the same on every CPU
+static void policyNoMigrate(pcb *aProc, cpu *from, cpu *to) {
+}
+
+// displays the ready queues of aCpu, each in FIFO order
+static void queuesShowReady(cpu *aCpu) {
+    pcb *currItem;
+    unsigned int i;
+    for (i = 0; i < numPriorities; i++) {
+        REPORT("----Displaying processes in Priority [%u] ready queue:\n", i);
+        QUEUEFOREACH(currItem, &aCpu->priorityQ[i], qPrev)
+            printProc(currItem);
+    }
+}
+
+// multi-level feedback queue: one queue per priority level, the top non-empty one runs first, and a process
+// is moved one level down every time it uses up its quantum (see the design decisions at the top)
+static void mlfqEnqueue(cpu *aCpu, pcb *aProc) {
+    procQueuePush(&aCpu->priorityQ[aProc->priority], aProc);
+    aCpu->readyLevels[aProc->priority / 64] |= 1ULL << (aProc->priority % 64);
+}
+
+// a boost that is due happens before the next process is picked, i.e. right after the quantum that made it due
+// (the quanta of every CPU count towards it, and it boosts the processes of every CPU)
+static pcb *mlfqPickNext(cpu *aCpu) {
+    if (boostInterval && quantaSinceBoost >= boostInterval)
+        boostPriorities();
+    return dequeueReady(aCpu);
+}
+
+static int mlfqOnQuantumExpire(pcb *aProc) {
+    if (aProc->priority < numPriorities - 1)
+        (aProc->priority)++;
+    if (boostInterval)
+        quantaSinceBoost++;
+    return 1;
+}
+
+// round robin and first come first served: one FIFO (priorityQ[0]) whatever the priority of the processes
+// round robin preempts the running process at the end of every quantum, first come first served never does,
+// a process then runs until it blocks or exits
+static void fifoEnqueue(cpu *aCpu, pcb *aProc) {
+    procQueuePush(&aCpu->priorityQ[0], aProc);
+}
+
+static pcb *fifoPickNext(cpu *aCpu) {
+    return dequeueProc(&aCpu->priorityQ[0]);
+}
+
+static int rrOnQuantumExpire(pcb *aProc) {
+    return 1;
+}
+
+static int fcfsOnQuantumExpire(pcb *aProc) {
+    return 0;
+}
+
+// completely fair scheduling: the ready processes of a CPU sit in its tree ordered by virtual runtime (see cfs.h),
+// a process is charged a quantum of virtual runtime whenever it gives the CPU up, preempted or blocked
+static void cfsReadyEnqueue(cpu *aCpu, pcb *aProc) {
+    cfsEnqueue(&aCpu->tree, aProc);
+}
+
+static pcb *cfsReadyPickNext(cpu *aCpu) {
+    return cfsPickNext(&aCpu->tree);
+}
+
+static int cfsReadyRemove(pcb *aProc) {
+    return cfsRemove(&cpus[aProc->cpuID].tree, aProc);
+}
+
+static int cfsOnQuantumExpire(pcb *aProc) {
+    cfsCharge(aProc);
+    return 1;
+}
+
+// the virtual runtimes of two trees are not comparable: the process keeps its lead over the minimum of its old
+// tree (which it cannot be behind of) on the new one
+static void cfsOnMigrate(pcb *aProc, cpu *from, cpu *to) {
+    aProc->vruntime = aProc->vruntime - from->tree.minVruntime + to->tree.minVruntime;
+}
+
+static void cfsShowReady(cpu *aCpu) {
+    pcb *currItem;
+    REPORT_PUTS("----Displaying processes in the ready tree, by virtual runtime:");
+    for (currItem = cfsFirst(&aCpu->tree); currItem; currItem = cfsNext(currItem)) {
+        printProc(currItem);
+        REPORT("\tVirtual runtime: %llu (weight %u)\n", currItem->vruntime, cfsWeight(currItem->priority));
+    }
+}
+
+const schedPolicy policies[] = {
+        {"mlfq", 1, mlfqEnqueue,     mlfqPickNext,     mlfqOnQuantumExpire, policyNoHook, policyNoHook,
+                policyNotQueued, policyNoMigrate, queuesShowReady},
+        {"rr",   0, fifoEnqueue,     fifoPickNext,     rrOnQuantumExpire,   policyNoHook, policyNoHook,
+                policyNotQueued, policyNoMigrate, queuesShowReady},
+        {"fcfs", 0, fifoEnqueue,     fifoPickNext,     fcfsOnQuantumExpire, policyNoHook, policyNoHook,
+                policyNotQueued, policyNoMigrate, queuesShowReady},
+        {"cfs",  0, cfsReadyEnqueue, cfsReadyPickNext, cfsOnQuantumExpire,  cfsCharge,    policyNoHook,
+                cfsReadyRemove,  cfsOnMigrate,    cfsShowReady},
+};
+_Thread_local const schedPolicy *policy = &policies[0];
+
+// |-------------------------------------------------------------------------|
+// |                      User Commands Implementations                      |
+// |-------------------------------------------------------------------------|
+
+// create a process and put it on the appropriate ready Q.
+int create_C() {
+    // create new process (the pcb)
+    pcb *newProc = createProc();
+
+    // enqueue process to the top of the priority queue
+    if (!newProc || enqueueProc(newProc) != 0) {    // failed
+        // purge new process
+        if (newProc) {
+            pidIndexRemove(&procIndex, newProc->pID);
+            procTableRemove(newProc->pID);
+            pcbSlabFree(newProc);
+        }
+        REPORT_PUTS("Process creation failed! Are all the queues full?");
+        return -1;
+    } else   // success
+    {
+        numProcs++;
+        outcome.pID = newProc->pID;
+        REPORT("Process successfully created! The Process ID assigned is %u\n", newProc->pID);
+        EVLOG(evlogCreate(newProc->pID, newProc->priority, 0, 0));
+    }
+    return 0;
+}
+
+// Copy the currently running process and put it on the ready Q corresponding to the original process' priority. 
+// Attempting to Fork the "init" process (see below) should fail. 
+// Report: success or failure, the pid of the resulting (new) process on success.
+int fork_F() {
+    if (runningProc == proc_init) {
+        REPORT_PUTS("Forking failed. Cannot fork the special process \"init\"\n");
+        return -1;
+    }
+
+    // create new process (the pcb)
+    pcb *newProc = createProc();
+    if (!newProc) {
+        REPORT_PUTS("Process creation failed in forking! Are all the queues full?");
+        return -1;
+    }
+    // copy pcb (a real-time task forks an ordinary process, its parameters are not admitted twice)
+    // the parent may have missed a boost while it was running
+    syncProc(runningProc);
+    newProc->priority = runningProc->priority;
+    newProc->vruntime = runningProc->vruntime;
+    mailboxCopy(&newProc->inbox, runningProc->inbox);
+    // newProc->state should be kept as READY
+
+    // enqueue process to the top of the priority queue
+    if (enqueueProc(newProc) != 0) {    // failed
+        // purge new process
+        pidIndexRemove(&procIndex, newProc->pID);
+        procTableRemove(newProc->pID);
+        mailboxFree(&newProc->inbox);
+        pcbSlabFree(newProc);
+        REPORT_PUTS("Process creation failed in forking! Are all the queues full?");
+        return -1;
+    } else   // success
+    {
+        numProcs++;
+        outcome.pID = newProc->pID;
+        REPORT("Process successfully forked! The Process ID assigned is %u\n", newProc->pID);
+        EVLOG(evlogCreate(newProc->pID, newProc->priority, runningProc->pID, 1));
+    }
+    return 0;
+}
+
+// kill the named process and remove it from the system.
+// Report: action taken as well as success or failure.
+int kill_K(unsigned int delPID) {
+    // look the process ID up, then take it out of the queue it sits in (if any)
+    // NOTE: the pcb is NOT deleted by unqueueProc()
+    pcb *procFound = pidIndexFind(&procIndex, delPID);
+    if (procFound)
+        unqueueProc(procFound);
+
+    // deletes if found
+    if (procFound) {
+        return deleteProc(procFound);
+    } else {
+        REPORT("Did not find the process with pID# = %u.\nDeletion failed.\n", delPID);
+        return -1;
+    }
+}
+
+// kill the currently running process. 
+// Report: process scheduling information (eg. which process now gets control of the CPU)
+int exit_E() {
+    // deletes if found (deleteProc() will filter if runningProc==proc_init
+    if (runningProc) {
+        return deleteProc(runningProc);
+    } else {
+#ifdef DEBUG
+        fprintf(stderr, "exit_E() failed! There is no runningProc!\n");
+#endif
+        return -1;
+    }
+}
+
+// time quantum of running process expires.
+// Report: action taken (eg. process scheduling information)
+int quantum_Q() {
+    // the quantum is accounted at the priority the process has now, which a boost may have changed
+    syncProc(runningProc);
+    REPORT_PUTS("The currently running process ");
+#ifdef DEBUG
+    REPORT_PUTS("\n");
+    printProc(runningProc);
+#endif
+#ifndef DEBUG
+    oneLinePrintProc(runningProc);
+#endif
+    statsOnQuantum(&runningProc->stats, runningProc->priority);
+    if (runningProc == proc_init)
+        curCpu->stats.idleQuanta++;
+    else
+        curCpu->stats.busyQuanta++;
+    if (EDFTASK(runningProc)) {
+        // a real-time task is always preempted, the earliest deadline runs next
+        int jobDone;
+        long lateness = edfOnQuantum(runningProc, &jobDone);
+        if (jobDone) {
+            statsOnJob(lateness);
+            if (lateness > 0)
+                REPORT("completed its job %ld ticks after its deadline (deadline missed), and ", lateness);
+            else
+                REPORT("completed its job %ld ticks before its deadline, and ", -lateness);
+        }
+    } else if (!policy->onQuantumExpire(runningProc) && runningProc != proc_init) {
+        REPORT("keeps the CPU (the %s policy does not preempt it).\n", policy->name);
+        return 0;
+    }
+    REPORT_PUTS("will now stop occupying the CPU.");
+    if (runningProc != proc_init)
+        runningProc->state = READY;
+    EVLOG(evlogPreempt(runningProc->pID, runningProc->priority));
+
+    // enqueueProc() returns 0 upon success (and rejects proc_init without tossing an error)
+    if (enqueueProc(runningProc)) {
+#ifdef DEBUG
+        fprintf(stderr, "enqueueProc(priorityQ[%u],currRunning (PID=%u)) Failed!\n", runningProc->priority,
+                runningProc->pID);
+#endif
+    }
+    runNextProc();
+    return 0;
+}
+
+// send a message to another process - block until reply. 
+// The message joins the mailbox of the recipient (nothing is overwritten), sending fails if that mailbox is full.
+// Report: success or failure, scheduling information, and reply source and text (once reply arrives)
+int send_S(unsigned int remotePID, char *msg) {
+    pcb *procFound;
+    int foundInWaiting_bool=0;	// used to print additional prompt
+    int slot;
+
+    // search for the process ID to be sent (remotePID). Sending to self is allowed
+    if ((procFound = pidIndexFind(&procIndex, remotePID)) == NULL) {
+        REPORT("Sending message \"%s\" to pID#%u failed: Cannot find process with pID#%u\n", msg, remotePID, remotePID);
+        return -1;
+    }
+    if ((slot = mailboxPut(&procFound->inbox, runningProc->pID, msg)) < 0) {
+        REPORT("Sending message \"%s\" to pID#%u failed: its mailbox is full (%d messages)\n", msg, remotePID,
+               MAILBOXSIZE);
+        return -1;
+    }
+    procTableSync(procFound);
+    // unblock the process if it waits to rcv, from anyone or from this sender
+    if (procFound->queue == &waitingRcv &&
+        (procFound->rcvFrom == MAILBOXANY || procFound->rcvFrom == runningProc->pID)) {
+        unqueueProc(procFound);
+        procFound->wakeSlot = (signed char) slot;
+        classOnUnblock(procFound);
+        enqueueProc(procFound);
+        foundInWaiting_bool=1;
+    }
+
+    REPORT("Successfully sent \"%s\" to process with pID#%u \n", msg, remotePID);
+    EVLOG(evlogSend(runningProc->pID, remotePID, msg));
+    if (foundInWaiting_bool)
+        EVLOG(evlogUnblock(procFound->pID));
+
+    REPORT("The current running process ");
+#ifdef DEBUG
+    REPORT_PUTS("");
+    printProc(runningProc);
+#endif
+#ifndef DEBUG
+    REPORT("with pID#%u and priority #%u ",runningProc->pID,runningProc->priority);
+#endif
+    // block running process if its not the special process
+    if (runningProc != proc_init) {
+        REPORT_PUTS("is now blocked waiting for reply.");
+        EVLOG(evlogBlock(runningProc->pID, BLOCKED_REPLY, 0));
+        classOnBlock(runningProc);
+        runningProc->state = BLOCKED;
+        procTableSync(runningProc);
+        statsOnBlock(&runningProc->stats, BLOCKED_REPLY);
+        procQueuePush(&waitingReply, runningProc);
+        runNextProc();
+    }else
+        REPORT_PUTS("is not blocked and still running as it is the speical \"init\" process.");
+
+    if(foundInWaiting_bool)
+    {
+        REPORT("The recipient process with pID#%u is now unblocked.\n", procFound->pID);
+
+    }
+    return 0;
+}
+
+// receive a message - block until one arrives 
+// fromPID selects the sender (selective receive), MAILBOXANY takes the oldest message from anyone
+// Report: scheduling information and (once msg is received) the message text and source of message
+int receive_R(unsigned int fromPID) {
+    // msg awaiting rcv exist
+    if (!mailboxTake(&runningProc->inbox, fromPID, &outcome.from, outcome.msg)) {
+        outcome.received = 1;
+        REPORT("You have a new message from sender pID#%u:\n", outcome.from);
+        REPORT("\"%s\"\n", outcome.msg);
+        EVLOG(evlogReceive(runningProc->pID, outcome.from, outcome.msg));
+        procTableSync(runningProc);
+    } else {
+        if (fromPID == MAILBOXANY)
+            REPORT_PUTS("No new messages.");
+        else
+            REPORT("No new messages from pID#%u.\n", fromPID);
+        if (runningProc != proc_init) {
+            REPORT("The current running process ");
+#ifdef DEBUG
+        	REPORT_PUTS("");
+			printProc(runningProc);
+#endif
+#ifndef DEBUG
+			REPORT("with pID#%u and priority #%u ",runningProc->pID,runningProc->priority);
+#endif
+            REPORT_PUTS("has been blocked to wait for reply");
+            EVLOG(evlogBlock(runningProc->pID, BLOCKED_RCV, 0));
+            classOnBlock(runningProc);
+            runningProc->state=BLOCKED;
+            runningProc->rcvFrom = fromPID;
+            procTableSync(runningProc);
+            statsOnBlock(&runningProc->stats, BLOCKED_RCV);
+            procQueuePush(&waitingRcv, runningProc);
+            runNextProc();
+        }
+    }
+    return 0;
+}
+
+// unblocks sender and delivers reply
+// Report: success or failure
+int reply_Y(unsigned int remotePID, char *msg) {
+    // search for the process ID to be sent (remotePID)
+    // if its not waiting for reply, do not allow the message to be sent
+    pcb *procFound = pidIndexFind(&procIndex, remotePID);
+    int slot;
+    if (!procFound || procFound->queue != &waitingReply) {
+        REPORT("Replying message \"%s\" to pID#%u failed: It is not waiting for a reply at this time (or it doesn't even exist)\n",
+               msg, remotePID);
+        return -1;
+    }
+    if ((slot = mailboxPut(&procFound->inbox, runningProc->pID, msg)) < 0) {
+        REPORT("Replying message \"%s\" to pID#%u failed: its mailbox is full (%d messages)\n", msg, remotePID,
+               MAILBOXSIZE);
+        return -1;
+    }
+    unqueueProc(procFound);
+    procFound->wakeSlot = (signed char) slot;
+    classOnUnblock(procFound);
+    enqueueProc(procFound);
+
+    REPORT("Successfully replied \"%s\" to process with pID#%u \n", msg, remotePID);
+    REPORT_PUTS("The recipient process is now unblocked");
+    EVLOG(evlogReply(runningProc->pID, remotePID, msg));
+    EVLOG(evlogUnblock(procFound->pID));
+    return 0;
+}
+
+// Initialize the named semaphore with the value given. 
+// ID's can take a value from 0 to MAXSEMS - 1, the table of semaphores grows as needed.
+// This can only be done once for a semaphore (until it is destroyed with D) - subsequent attempts result in error.
+// Report: action taken as well as success or failure.
+int sem_N(unsigned int semID, int initVal) {
+    if (semID >= MAXSEMS) {
+        REPORT("Semaphore #%u is too large.\nOnly value 0-%u is acceptable. Please try again.\n", semID, MAXSEMS - 1);
+        return -1;
+    } else if (findSem(semID)) {
+        REPORT("Semaphore #%u is already in use.\n", semID);
+        return -1;
+    } else {
+        if (semID >= semTableSize) {
+            unsigned int newSize = semTableSize ? semTableSize : 16;
+            while (newSize <= semID)
+                newSize *= 2;
+            sem *newTable = realloc(sems, newSize * sizeof(sem));
+            if (!newTable) {
+                REPORT("Semaphore #%u could not be initialized: out of memory\n", semID);
+                return -1;
+            }
+            memset(newTable + semTableSize, 0, (newSize - semTableSize) * sizeof(sem));
+            sems = newTable;
+            semTableSize = newSize;
+        }
+        // the wait queue is only allocated once a process blocks
+        sems[semID] = (sem) {initVal, 1, NULL};
+        REPORT("Semaphore #%u is successfully initialized to %d.\n", semID, initVal);
+    }
+    return 0;
+}
+
+// execute the semaphore P operation on behalf of the running process. 
+// Report: action taken (blocked or not) as well as success or failure.
+int sem_P(unsigned int semID) {
+    sem *aSem = findSem(semID);
+
+    if (!aSem) {
+        REPORT("The semaphore #%u you have attempted to use is not yet initialized.\n Use command \"N %u [Initial Value]\" first.\n",
+               semID, semID);
+        return -1;
+    } else if (runningProc == proc_init) {
+        REPORT("The P operation on semaphore #%u failed because blocking the special process \"init\" is prohibited.\n",
+               semID);
+        return -1;
+    } else if (aSem->sem <= 0 && !aSem->procs && !(aSem->procs = calloc(1, sizeof(procQueue)))) {
+        REPORT("The P operation on semaphore #%u failed: out of memory\n", semID);
+        return -1;
+    } else
+        REPORT("The P operation on semaphore #%u was successfully executed.\n", semID);
+
+    REPORT("The current running process ");
+#ifdef DEBUG
+    	REPORT_PUTS("");
+		printProc(runningProc);
+#endif
+#ifndef DEBUG
+		REPORT("with pID#%u and priority #%u ",runningProc->pID,runningProc->priority);
+#endif
+    if (aSem->sem <= 0) {    // implement blocking
+        classOnBlock(runningProc);
+        runningProc->state = BLOCKED;
+        procTableSync(runningProc);
+        statsOnBlock(&runningProc->stats, BLOCKED_SEM);
+        procQueuePush(aSem->procs, runningProc);
+        REPORT_PUTS("is now blocked.\n");
+        (aSem->sem)--;
+        EVLOG(evlogSem(EV_SEM_P, runningProc->pID, semID, aSem->sem));
+        EVLOG(evlogBlock(runningProc->pID, BLOCKED_SEM, semID));
+        REPORT("The value of this semaphore is now %d\n", aSem->sem);
+        runNextProc();
+    } else{
+        REPORT_PUTS("is not blocked and still running.");
+        (aSem->sem)--;
+        EVLOG(evlogSem(EV_SEM_P, runningProc->pID, semID, aSem->sem));
+        REPORT("The value of this semaphore is now %d\n", aSem->sem);
+    }
+    return 0;
+}
+
+// readies a process that was blocked by a semaphore
+static void readySemProc(pcb *poppedProc) {
+    REPORT("The process ");
+#ifdef DEBUG
+    REPORT_PUTS("");
+    printProc(poppedProc);
+#endif
+#ifndef DEBUG
+    REPORT("with pID#%u and priority #%u ",poppedProc->pID,poppedProc->priority);
+#endif
+    REPORT_PUTS("is now readied");
+    EVLOG(evlogUnblock(poppedProc->pID));
+    poppedProc->state=READY;
+    classOnUnblock(poppedProc);
+    enqueueProc(poppedProc);
+}
+
+// execute the semaphore V operation on behalf of the running process. 
+// Report: action taken (whether/ which process was readied) as well as success or failure.
+int sem_V(unsigned int semID) {
+    sem *aSem = findSem(semID);
+    pcb *poppedProc;
+
+    if (!aSem) {
+        REPORT("The semaphore #%u you have attempted to use is not yet initialized.\n Use command \"N %u\" first.\n",
+               semID, semID);
+        return -1;
+    } else
+        REPORT("The V operation on semaphore #%u was successfully executed.\n", semID);
+
+    if (aSem->procs && (poppedProc = dequeueProc(aSem->procs)) != NULL)
+        readySemProc(poppedProc);
+    else
+        REPORT("No process was readied as no process was blocked by semaphore #%u\n", semID);
+
+    (aSem->sem)++;
+    REPORT("The value of this semaphore is now %d\n", aSem->sem);
+    EVLOG(evlogSem(EV_SEM_V, runningProc->pID, semID, aSem->sem));
+    return 0;
+}
+
+// destroy the named semaphore and free its wait queue. Every process it blocks is readied first, in the
+// order they were blocked. The ID can then be initialized again with N.
+// Report: action taken as well as success or failure.
+int sem_D(unsigned int semID) {
+    sem *aSem = findSem(semID);
+    pcb *poppedProc;
+
+    if (!aSem) {
+        REPORT("The semaphore #%u you have attempted to destroy is not initialized.\n", semID);
+        return -1;
+    }
+    if (aSem->procs) {
+        while ((poppedProc = dequeueProc(aSem->procs)) != NULL)
+            readySemProc(poppedProc);
+        free(aSem->procs);
+    }
+    *aSem = (sem) {0, 0, NULL};
+    REPORT("Semaphore #%u is destroyed.\n", semID);
+    EVLOG(evlogSemDestroy(runningProc->pID, semID));
+    return 0;
+}
+
+// dump complete state information of process to screen 
+// (this includes process state and anything else you can think of)
+int procinfo_I(unsigned int pID) {
+    pcb *procFound = pidIndexFind(&procIndex, pID);
+
+    if (procFound) {
+        printProc(procFound);
+        if (!quiet) {
+            REPORT_PUTS("\tScheduling accounting (in ticks, the clock advances on every dispatch):");
+            statsPrintProc(REPORTFILE, &procFound->stats);
+        }
+        return 0;
+    } else {
+        REPORT("The Process ID you requested does not belong to any created process. Please try again.\n");
+        return -1;
+    }
+}
+
+// display all process queues and their contents
+int totalinfo_T() {
+    pcb *currItem;
+    REPORT_PUTS("--Displaying processes in readied queues by semaphores\n");
+    // every queue is displayed in FIFO order, from its tail (next to leave) to its head,
+    // and the ready set of each CPU in the order the policy would run it
+    for (unsigned int c = 0; c < numCpus; c++) {
+        if (numCpus > 1)
+            REPORT("----CPU #%u:\n", c);
+        policy->showReady(&cpus[c]);
+    }
+    edfShow();
+
+    REPORT_PUTS("\n--Displaying processes controlled by semaphores\n");
+    for (unsigned int i = 0; i < semTableSize; i++) {
+        if (sems[i].inUse) {
+            REPORT("----Displaying processes controlled by active semaphore #%u :\n", i);
+            if (sems[i].procs)
+                QUEUEFOREACH(currItem, sems[i].procs, qPrev)
+                    printProc(currItem);
+        }
+
+    }
+
+    REPORT("\n--Displaying processes blocked waiting to receive a message:\n");
+    QUEUEFOREACH(currItem, &waitingRcv, qPrev)
+        printProc(currItem);
+
+    REPORT("\n--Displaying processes that has sent a message and blocked waiting for a reply:\n");
+    QUEUEFOREACH(currItem, &waitingReply, qPrev)
+        printProc(currItem);
+    if (numCpus > 1) {
+        REPORT_PUTS("\n--The processes that are currently running are:");
+        for (unsigned int c = 0; c < numCpus; c++) {
+            REPORT("----On CPU #%u%s:\n", c, &cpus[c] == curCpu ? " (the current CPU)" : "");
+            printProc(cpus[c].running);
+        }
+        return 0;
+    }
+    REPORT_PUTS("\n--The process that is currently running is:");
+    printProc(runningProc);
+    return 0;
+}
+
+// summarize every process at once from the process table (see proctable.h): how many are in each state
+// and at each priority level, and which ones have messages waiting. No queue nor pcb is looked at.
+// Report: the counts, and the pIDs of up to OVERVIEWMAXPIDS processes with messages waiting
+int overview_O() {
+    unsigned long byState[BLOCKED + 1];
+    unsigned long byPriority[MAXPRIORITIES];
+    unsigned int pIDs[OVERVIEWMAXPIDS];
+    unsigned long numPending, numListed, i;
+
+    for (i = READY; i <= BLOCKED; i++)
+        byState[i] = procTableCount(PROCSTATE, i);
+    for (i = 0; i < numPriorities; i++)
+        byPriority[i] = procTableCount(PROCPRIORITY, i);
+    numPending = procTableCount(PROCPENDING, 1);
+    numListed = procTableFilter(PROCPENDING, 1, pIDs, OVERVIEWMAXPIDS);
+
+    REPORT("--Overview of the %u processes (\"init\" included):\n", numProcs + 1);
+    REPORT("----By state:");
+    for (i = READY; i <= BLOCKED; i++)
+        REPORT(" %s %lu", enumStrings[i], byState[i]);
+    REPORT("\n----By priority:");
+    for (i = 0; i < numPriorities; i++)
+        REPORT(" [%lu] %lu", i, byPriority[i]);
+    REPORT("\n----With messages waiting to be received: %lu", numPending);
+    for (i = 0; i < numListed; i++)
+        REPORT("%s%u", i ? ", " : " (pID#", pIDs[i]);
+    if (numListed)
+        REPORT("%s)", numPending > numListed ? ", ..." : "");
+    REPORT_PUTS("");
+    return 0;
+}
+
+// display the scheduling accounting of the processes that exited so far, per priority level
+int accounting_A() {
+    if (!quiet)
+        statsPrintSummary(REPORTFILE);
+    return 0;
+}
+
+// change the priority of the named process. It is looked up through the PID index, and if it is ready
+// under a policy queueing by priority (see schedPolicy::byPriority) it moves straight to the ready queue of its
+// new priority, otherwise it keeps its place in line. A running or blocked process keeps its new
+// priority for its next enqueue.
+// Report: success or failure
+int renice_L(unsigned int pID, unsigned int newPriority) {
+    pcb *procFound = pidIndexFind(&procIndex, pID);
+
+    if (procFound)
+        syncProc(procFound);
+    if (newPriority >= numPriorities)
+        REPORT("Priority #%u is too large.\nOnly value 0-%u is acceptable. Please try again.\n", newPriority,
+               numPriorities - 1);
+    else if (!procFound)
+        REPORT("Did not find the process with pID# = %u.\nChanging its priority failed.\n", pID);
+    else if (procFound == proc_init)
+        REPORT_PUTS("Changing the priority of the special process \"init\" is not allowed.");
+    else {
+        unsigned int oldPriority = procFound->priority;
+        procFound->priority = newPriority;
+        if (oldPriority != newPriority && policy->byPriority && isReadyQueue(procFound)) {
+            unqueueProc(procFound);
+            enqueueProc(procFound);
+        }
+        procTableSync(procFound);
+        REPORT("The priority of the process with pID#%u was changed from %u to %u\n", pID, oldPriority, newPriority);
+        EVLOG(evlogRenice(pID, newPriority));
+        return 0;
+    }
+    return -1;
+}
+
+// create a real-time task releasing a job every period ticks, due deadline ticks after its release and needing
+// budget quanta, and put it on the real-time ready set. It is rejected if the task set would then overload the
+// CPU (see edf.h), so that the admitted tasks never miss a deadline on their own account.
+// Report: success or failure, the pid of the new task on success
+int realtime_X(unsigned int period, unsigned int deadline, unsigned int budget) {
+    if (!period || !deadline || !budget) {
+        REPORT_PUTS("The period, deadline and budget of a real-time task must all be positive.");
+        return -1;
+    }
+    if (edfAdmit(period, deadline, budget)) {
+        REPORT("Real-time task rejected: it needs %.1f%% of the CPU, %.1f%% is left to real-time tasks.\n",
+               100.0 * budget / (deadline < period ? deadline : period), 100.0 * (1.0 - edfDensity));
+        return -1;
+    }
+    pcb *newProc = createProc();
+    if (!newProc) {
+        REPORT_PUTS("Process creation failed! Are all the queues full?");
+        return -1;
+    }
+    edfStart(newProc, period, deadline, budget);
+    enqueueProc(newProc);
+    numProcs++;
+    outcome.pID = newProc->pID;
+    REPORT("Real-time task successfully created! The Process ID assigned is %u, the real-time tasks now use %.1f%% of the CPU\n",
+           newProc->pID, 100.0 * edfDensity);
+    EVLOG(evlogCreate(newProc->pID, newProc->priority, 0, 0));
+    return 0;
+}
+
+// make cpuID the current CPU: the commands acting on the running process (Q, E, F, S, R, P...) act on the one
+// running on cpuID from now on, and the processes created or forked from now on join its ready set
+// Report: success or failure, and the process running on the new current CPU
+int cpu_U(unsigned int cpuID) {
+    if (cpuID >= numCpus) {
+        REPORT("CPU #%u does not exist.\nOnly value 0-%u is acceptable. Please try again.\n", cpuID, numCpus - 1);
+        return -1;
+    }
+    curCpu = &cpus[cpuID];
+    runningProc = curCpu->running;
+    REPORT("CPU #%u is now the current CPU. The process running on it is:\n", cpuID);
+    oneLinePrintProc(runningProc);
+    return 0;
+}
+
+// |-------------------------------------------------------------------------|
+// |                          Simulation Lifecycle                           |
+// |-------------------------------------------------------------------------|
+
+// sets the number of priority levels of the next simulation
+int simSetPriorities(unsigned int levels) {
+    if (levels < 1 || levels > MAXPRIORITIES)
+        return -1;
+    numPriorities = levels;
+    return 0;
+}
+
+// sets the number of simulated CPUs of the next simulation
+int simSetCpus(unsigned int n) {
+    if (n < 1 || n > MAXCPUS)
+        return -1;
+    numCpus = n;
+    return 0;
+}
+
+// sets the scheduling policy of the next simulation
+const schedPolicy *simFindPolicy(const char *name) {
+    int i;
+    for (i = 0; i < sizeof policies / sizeof policies[0]; i++) {
+        if (!strcmp(policies[i].name, name))
+            return &policies[i];
+    }
+    return NULL;
+}
+
+int simSetPolicy(const char *name) {
+    const schedPolicy *found = simFindPolicy(name);
+    if (!found)
+        return -1;
+    policy = found;
+    return 0;
+}
+
+// sets the interval of the priority boost of the next simulation
+void simSetBoost(unsigned int quanta) {
+    boostInterval = quanta;
+}
+
+// creates the CPUs, their queues and the special "init" process
+void simInit() {
+    int i;
+
+    // initialize the CPUs and their queues, all the ready queues in one block
+    cpus = calloc(numCpus, sizeof(cpu));
+    procQueue *readyQueues = calloc((size_t) numCpus * numPriorities, sizeof(procQueue));
+    if (!cpus || !readyQueues) {
+        fprintf(stderr, "The %u CPUs could not be allocated\n", numCpus);
+        exit(1);
+    }
+    for (i = 0; i < numCpus; i++) {
+        cpus[i].id = i;
+        cpus[i].priorityQ = readyQueues + (size_t) i * numPriorities;
+        cfsReset(&cpus[i].tree);
+    }
+    memset(stealable, 0, sizeof stealable);
+    curCpu = &cpus[0];
+    waitingReply = (procQueue) {NULL, NULL, 0};    // used for sender blocked until reply
+    waitingRcv = (procQueue) {NULL, NULL, 0};      // used for rcvers blocked until received
+
+    // global variables initialization
+    if (statsReset())
+        fprintf(stderr, "The scheduling accounting could not be allocated, exiting processes will not be accounted\n");
+    run = 1;
+    numProcs = 0;
+    quantaSinceBoost = 0;
+    boostEpoch = 0;
+    proc_init = createProc();     // proc_init is set to run at the beginning
+    proc_init->state = RUNNING;
+    procTableSync(proc_init);
+    for (i = 0; i < numCpus; i++)     // every CPU is idle
+        cpus[i].running = proc_init;
+    numIdle = numCpus;
+    runningProc = proc_init;       // ptr to the process that is currently running
+}
+
+// frees every remaining process and queue
+// every pcb comes from the slabs, so they all go at once, queued, blocked or running
+void simCleanup() {
+    int i;
+
+    free(cpus[0].priorityQ);     // the ready queues of every CPU
+    free(cpus);
+    cpus = curCpu = NULL;
+    memset(stealable, 0, sizeof stealable);
+    for (i = 0; i < semTableSize; i++)
+        free(sems[i].procs);
+    free(sems);
+    sems = NULL;
+    semTableSize = 0;
+    waitingReply = (procQueue) {NULL, NULL, 0};
+    waitingRcv = (procQueue) {NULL, NULL, 0};
+    runningProc = proc_init = NULL;
+    pcbSlabRelease();
+    mailboxRelease();
+    edfFree();
+    pidIndexFree(&procIndex);
+    procTableFree();
+    statsFree();
+}
+
+// the thread local variables of sim.c, and the state of each module
+struct simState {
+    const schedPolicy *policy;
+    unsigned int numPriorities;
+    unsigned int numCpus;
+    cpu *cpus;
+    cpu *curCpu;
+    unsigned long long stealable[CPUWORDS];
+    unsigned int numIdle;
+    unsigned int boostInterval;
+    unsigned int quantaSinceBoost;
+    unsigned int boostEpoch;
+    sem *sems;
+    unsigned int semTableSize;
+    procQueue waitingReply;
+    procQueue waitingRcv;
+    unsigned int numProcs;
+    pidIndex procIndex;
+    unsigned int run;
+    pcb *proc_init;
+    pcb *runningProc;
+    unsigned int quiet;
+    FILE *reportFile;
+    cmdOutcome outcome;
+    pcbSlabState *slab;
+    mailboxState *mailbox;
+    edfState *edf;
+    procTableState *table;
+    statsState *stats;
+};
+
+simState *simStateCreate() {
+    simState *state = calloc(1, sizeof(simState));
+    if (!state)
+        return NULL;
+    state->policy = &policies[0];
+    state->numPriorities = DEFAULTPRIORITIES;
+    state->numCpus = 1;
+    state->procIndex = (pidIndex) PIDINDEXEMPTY;
+    state->slab = pcbSlabStateCreate();
+    state->mailbox = mailboxStateCreate();
+    state->edf = edfStateCreate();
+    state->table = procTableStateCreate();
+    state->stats = statsStateCreate();
+    if (!state->slab || !state->mailbox || !state->edf || !state->table || !state->stats) {
+        simStateFree(state);
+        return NULL;
+    }
+    return state;
+}
+
+void simSwap(simState *state) {
+    SIMSWAP(policy, state->policy);
+    SIMSWAP(numPriorities, state->numPriorities);
+    SIMSWAP(numCpus, state->numCpus);
+    SIMSWAP(cpus, state->cpus);
+    SIMSWAP(curCpu, state->curCpu);
+    SIMSWAP(stealable, state->stealable);
+    SIMSWAP(numIdle, state->numIdle);
+    SIMSWAP(boostInterval, state->boostInterval);
+    SIMSWAP(quantaSinceBoost, state->quantaSinceBoost);
+    SIMSWAP(boostEpoch, state->boostEpoch);
+    SIMSWAP(sems, state->sems);
+    SIMSWAP(semTableSize, state->semTableSize);
+    SIMSWAP(waitingReply, state->waitingReply);
+    SIMSWAP(waitingRcv, state->waitingRcv);
+    SIMSWAP(numProcs, state->numProcs);
+    SIMSWAP(procIndex, state->procIndex);
+    SIMSWAP(run, state->run);
+    SIMSWAP(proc_init, state->proc_init);
+    SIMSWAP(runningProc, state->runningProc);
+    SIMSWAP(quiet, state->quiet);
+    SIMSWAP(reportFile, state->reportFile);
+    SIMSWAP(outcome, state->outcome);
+    pcbSlabSwap(state->slab);
+    mailboxSwap(state->mailbox);
+    edfSwap(state->edf);
+    procTableSwap(state->table);
+    statsSwap(state->stats);
+}
+
+void simStateFree(simState *state) {
+    if (!state)
+        return;
+    free(state->slab);
+    free(state->mailbox);
+    free(state->edf);
+    free(state->table);
+    free(state->stats);
+    free(state);
+}
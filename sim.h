@@ -0,0 +1,280 @@
+//// Simulation core of the OS Process Scheduling Simulation
+//// Declares the data structures, global state and the user commands implemented in sim.c
+//// The command handlers do not read any input, so they can be driven by the interactive client (main.c)
+//// as well as by any other front end (e.g. a command trace)
+////
+//// Created on: Oct 16, 2026
+#pragma once
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define MAXSEMS (1 << 20)   // semaphore IDs go from 0 to MAXSEMS - 1
+
+// number of priority levels (ready queues) of the scheduler, chosen at start time (see simSetPriorities())
+// up to MAXPRIORITIES, which can be raised at compile time with -DMAXPRIORITIES=...
+#ifndef MAXPRIORITIES
+#define MAXPRIORITIES 140
+#endif
+#define DEFAULTPRIORITIES 3
+#define LEVELWORDS ((MAXPRIORITIES + 63) / 64)
+
+// number of simulated CPUs, chosen at start time (see simSetCpus()), up to MAXCPUS
+// which can be raised at compile time with -DMAXCPUS=...
+#ifndef MAXCPUS
+#define MAXCPUS 1024
+#endif
+#define CPUWORDS ((MAXCPUS + 63) / 64)
+
+#define OVERVIEWMAXPIDS 20  // pIDs listed by the O command
+
+// DEBUG macro is used to turn on various debugging features
+// Disable at the release version
+// #define DEBUG
+// #define DEBUG2	//DEBUG2 macro is used for a less verbose debugging, also disabled at release ofc
+
+#include "evlog.h"
+#include "stats.h"
+#include "pidindex.h"
+#include "pcbslab.h"
+#include "mailbox.h"
+#include "proctable.h"
+#include "typedqueue.h"
+#include "cfs.h"
+#include "edf.h"
+
+// every report of the simulation goes through these, so that quiet mode (see evlog.h) can silence them
+// and a front end can send them elsewhere than stdout (see reportFile)
+#define REPORTFILE (reportFile ? reportFile : stdout)
+#define REPORT(...) do { if (!quiet) fprintf(REPORTFILE, __VA_ARGS__); } while (0)
+#define REPORT_PUTS(str) do { if (!quiet) { fputs(str, REPORTFILE); fputc('\n', REPORTFILE); } } while (0)
+
+
+// |-------------------------------------------------------------------------|
+// |                    Data Structures                                      |
+// |-------------------------------------------------------------------------|
+// keywords used for states in pcb
+typedef enum {
+    READY = 0,
+    RUNNING,
+    BLOCKED
+} state;
+// the reasons a process can be BLOCKED for
+typedef enum {
+    BLOCKED_SEM = 0,    // by a semaphore P operation
+    BLOCKED_RCV,        // waiting to receive a message
+    BLOCKED_REPLY       // has sent a message and waits for the reply
+} blockCause;
+
+// intrusive FIFO of processes: the links live in the pcb itself (see pcb.qPrev/qNext/queue),
+// so queueing a process allocates nothing and a process is taken out of its queue in O(1)
+// processes are queued at the head and leave from the tail. Its operations (procQueuePush(), procQueuePop(),
+// procQueueRemove() and procQueueSplice()) are generated right after the pcb, see typedqueue.h
+QUEUETYPE(procQueue, pcb)
+
+// Process Control block. 1 for each process
+// contains info about the process
+typedef struct pcb {
+    unsigned int pID;    // process ID
+    // only 1 byte unsigned int is needed
+    // https://stackoverflow.com/a/9966679
+    unsigned int priority;   // 0: top; numPriorities - 1: low
+    state state;
+    mailbox *inbox;     // messages waiting to be received, in arrival order (NULL if none, see mailbox.h)
+    unsigned int rcvFrom;   // while blocked waiting to receive: the sender waited for (MAILBOXANY: anyone)
+    // once unblocked by a message or a reply: the inbox slot of that message, received when the process next
+    // runs (-1 if none)
+    signed char wakeSlot;
+    procStats stats;    // scheduling accounting, kept up to date on every state change (see stats.h)
+    struct pcb *qPrev;  // neighbour towards the head of the queue holding this process
+    struct pcb *qNext;  // neighbour towards the tail (i.e. the process leaving before this one)
+    procQueue *queue;   // the queue holding this process, NULL if it is in none (e.g. running)
+    unsigned int epoch; // boostEpoch when priority and queue were last brought up to date (see syncProc())
+    // completely fair scheduling only (see cfs.h)
+    cfsNode rb;                     // links of the ready tree
+    unsigned long long vruntime;    // virtual runtime
+    unsigned long long cfsSeq;      // enqueue order, orders the processes of equal virtual runtime
+    edfTask rt;                     // real-time parameters, rt.period is 0 for any other process (see edf.h)
+    unsigned int cpuID; // the CPU whose ready set holds the process, or that runs it or last ran it
+} pcb;
+
+QUEUEOPS(procQueue, pcb, qPrev, qNext, queue)
+
+// a simulated CPU: it runs one process at a time, out of a ready set of its own that the scheduling policy
+// keeps per CPU. A process stays on its CPU (it is readied where it last ran, and created or forked on the
+// current CPU), until a CPU that finds its own ready set empty steals it (see runNextProc())
+// "init" is the idle process of every CPU, so it can be running on several of them at once
+typedef struct cpu {
+    unsigned int id;
+    pcb *running;           // the process running on this CPU, proc_init if it is idle
+    unsigned int numReady;  // processes in the ready set of this CPU (real-time tasks are in none)
+    procQueue *priorityQ;   // one ready queue per priority level, numPriorities of them
+    // bitmap of the priority levels, bit p is set while priorityQ[p] may hold a process
+    // a bit is set on every enqueue, and only cleared by the dispatcher once it finds the level empty
+    // (processes leaving a ready queue otherwise, e.g. killed, leave it set), so the next process is
+    // found with a find-first-set per word instead of probing every level
+    unsigned long long readyLevels[LEVELWORDS];
+    cfsTree tree;           // ready set of the cfs policy
+    cpuStats stats;
+} cpu;
+
+// a scheduling policy: it owns the ready set of each CPU and decides which process runs next on it (see the
+// policies in sim.c). Real-time tasks are left out of it, they are scheduled ahead of it by earliest deadline
+// first (see edf.h)
+// the command handlers only go through these hooks, none of which is ever given proc_init but onQuantumExpire
+typedef struct schedPolicy {
+    const char *name;
+    int byPriority;                         // set if the ready queue of a process depends on its priority
+    void (*enqueue)(cpu *aCpu, pcb *aProc); // puts the ready process aProc into the ready set of aCpu
+    pcb *(*pickNext)(cpu *aCpu);            // takes the next process to run out of the ready set of aCpu,
+                                            // NULL if it is empty
+    // the running process aProc used up its quantum: returns 1 to preempt it, 0 to let it keep the CPU
+    // (proc_init always gives the CPU up)
+    int (*onQuantumExpire)(pcb *aProc);
+    void (*onBlock)(pcb *aProc);            // the running process aProc is about to block
+    void (*onUnblock)(pcb *aProc);          // the blocked process aProc is about to be readied
+    // takes aProc out of the ready set of its CPU if it sits in it outside of any procQueue, returns 1 if it
+    // did (nothing to do for the policies using the ready queues)
+    int (*remove)(pcb *aProc);
+    // the ready process aProc, taken out of the ready set of from, is about to run on to
+    void (*onMigrate)(pcb *aProc, cpu *from, cpu *to);
+    void (*showReady)(cpu *aCpu);           // displays the ready set of aCpu, in the order it would run
+} schedPolicy;
+
+// semaphore data struct to be provided to the user
+// the semaphores live in a table indexed by semID (sems), grown as higher IDs get initialized
+typedef struct sem {
+    int sem;
+    int inUse;          // set by N, cleared by D
+    procQueue *procs;   // the processes blocked by this semaphore, allocated by the first P that blocks
+} sem;
+
+// the state of the simulation is thread local: each thread runs a simulation of its own (see sweep.h), and can
+// keep others aside in simStates (see simSwap())
+// what the last command did besides its report, for the front ends that do not read the reports (see simapi.h)
+// it is only ever written, a front end clears it before a command and reads it after
+typedef struct cmdOutcome {
+    unsigned int pID;               // process created by C, F or X
+    int received;                   // set if R received a message right away
+    unsigned int from;              // its sender
+    char msg[MAILBOXMSGSIZE];       // and its text
+} cmdOutcome;
+
+extern char *enumStrings[];
+extern _Thread_local const schedPolicy *policy;
+extern _Thread_local unsigned int numPriorities;
+extern _Thread_local unsigned int numCpus;
+extern _Thread_local cpu *cpus;
+extern _Thread_local cpu *curCpu;
+extern _Thread_local unsigned int boostInterval;
+extern _Thread_local unsigned int boostEpoch;
+extern _Thread_local sem *sems;
+extern _Thread_local unsigned int semTableSize;
+extern _Thread_local procQueue waitingReply;
+extern _Thread_local procQueue waitingRcv;
+extern _Thread_local unsigned int numProcs;
+extern _Thread_local pidIndex procIndex;
+extern _Thread_local unsigned int run;
+extern _Thread_local pcb *proc_init;
+extern _Thread_local pcb *runningProc;     // the process running on the current CPU (curCpu->running)
+extern _Thread_local unsigned int quiet;
+extern _Thread_local FILE *reportFile;
+extern _Thread_local cmdOutcome outcome;
+
+
+// |-------------------------------------------------------------------------|
+// |                          Simulation Lifecycle                           |
+// |-------------------------------------------------------------------------|
+
+// sets the number of priority levels of the next simulation, before simInit()
+// returns 0 on success, -1 if levels is not within 1-MAXPRIORITIES
+int simSetPriorities(unsigned int levels);
+
+// sets the number of simulated CPUs of the next simulation, before simInit()
+// returns 0 on success, -1 if n is not within 1-MAXCPUS
+int simSetCpus(unsigned int n);
+
+// the scheduling policy called name, NULL if there is no such policy
+const schedPolicy *simFindPolicy(const char *name);
+
+// sets the scheduling policy of the next simulation, by name: "mlfq" (the default), "rr", "fcfs" or "cfs"
+// returns 0 on success, -1 if there is no such policy
+int simSetPolicy(const char *name);
+
+// makes the next simulation move every process back to the top priority every quanta quanta (0: never)
+void simSetBoost(unsigned int quanta);
+
+// creates the CPUs, their queues and the special "init" process. CPU 0 is the current CPU
+void simInit();
+
+// frees every remaining process (all pcb slabs at once), the PID index and the accounting
+void simCleanup();
+
+// the whole state of a simulation (that of sim.c and of every module it uses) kept aside while the thread runs
+// another one: the handlers act on the simulation in the thread local variables, simSwap() exchanges it with
+// the one kept in a simState (see simSession in simapi.c). The event log is the thread's, not a simulation's
+typedef struct simState simState;
+
+// allocates the state of a simulation not set up yet, with the default settings: once swapped in, it is set up
+// like any other (simSetPolicy()..., then simInit())
+// returns NULL if it cannot be allocated
+simState *simStateCreate();
+
+// exchanges the simulation of the thread with the one kept in state
+void simSwap(simState *state);
+
+// frees state, whose simulation was cleaned up (see simCleanup()) or never set up
+void simStateFree(simState *state);
+
+// exchanges the thread local var with saved, its copy in the simState of the module owning var
+#define SIMSWAP(var, saved) \
+    do { \
+        char swapTmp[sizeof(var)]; \
+        memcpy(swapTmp, &(var), sizeof(var)); \
+        memcpy(&(var), &(saved), sizeof(var)); \
+        memcpy(&(saved), swapTmp, sizeof(var)); \
+    } while (0)
+
+// |-------------------------------------------------------------------------|
+// |                          Helper Functions                               |
+// |-------------------------------------------------------------------------|
+
+int printProc(pcb *procFound);
+int oneLinePrintProc(pcb * procPrint);
+pcb *dequeueProc(procQueue *queue);
+void unqueueProc(pcb *aProc);
+void syncProc(pcb *aProc);
+void boostPriorities();
+int thereIsNoProc();
+unsigned int countProcs();
+int enqueueProc(pcb *aProc);
+pcb *createProc();
+void runNextProc();
+int deleteProc(pcb *delProc);
+
+// |-------------------------------------------------------------------------|
+// |                      User Commands Implementations                      |
+// |-------------------------------------------------------------------------|
+
+// each returns 0 if the command was carried out, -1 if it was refused (its report says why)
+
+int create_C();
+int fork_F();
+int kill_K(unsigned int delPID);
+int exit_E();
+int quantum_Q();
+int send_S(unsigned int remotePID, char *msg);
+int receive_R(unsigned int fromPID);
+int reply_Y(unsigned int remotePID, char *msg);
+int sem_N(unsigned int semID, int initVal);
+int sem_P(unsigned int semID);
+int sem_V(unsigned int semID);
+int sem_D(unsigned int semID);
+int procinfo_I(unsigned int pID);
+int totalinfo_T();
+int overview_O();
+int accounting_A();
+int renice_L(unsigned int pID, unsigned int newPriority);
+int realtime_X(unsigned int period, unsigned int deadline, unsigned int budget);
+int cpu_U(unsigned int cpuID);
@@ -0,0 +1,250 @@
+//// Embeddable simulator API
+//// See simapi.h for the interface
+////
+//// Created on: Oct 16, 2026
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "simapi.h"
+
+// a session: the handlers act on the simulation in the thread local variables of sim.c and its modules, so the
+// session whose simulation it is stays bound to the thread until a call on another session swaps them
+struct simSession {
+    simState *state;        // its simulation while it is not bound, else the one it took the place of
+    const char *owner;      // threadMark of the thread that opened it
+};
+
+// the session bound to the calling thread, NULL if none
+static _Thread_local simSession *boundSession = NULL;
+
+// only its address matters: it tells the threads apart
+static _Thread_local char threadMark;
+
+
+// |-------------------------------------------------------------------------|
+// |                          Helper Functions                               |
+// |-------------------------------------------------------------------------|
+
+// makes the simulation of session the one of the calling thread
+// returns 0 on success, -1 if there is no session or it belongs to another thread
+static int bindSession(simSession *session) {
+    if (!session || session->owner != &threadMark)
+        return -1;
+    if (session != boundSession) {
+        if (boundSession)
+            simSwap(boundSession->state);
+        simSwap(session->state);
+        boundSession = session;
+    }
+    return 0;
+}
+
+// gives the thread back the simulation the bound session took the place of
+static void unbindSession() {
+    simSwap(boundSession->state);
+    boundSession = NULL;
+}
+
+// checks every option of opts, then applies them to the simulation of the calling thread, not set up yet
+// returns 0 on success, -1 if one of them is invalid (nothing is applied then) or the processes cannot be reserved
+static int applyOptions(const simOptions *opts) {
+    const char *policyName = opts->policy ? opts->policy : "mlfq";
+    unsigned int levels = opts->levels ? opts->levels : DEFAULTPRIORITIES;
+    unsigned int numCpus = opts->cpus ? opts->cpus : 1;
+
+    if (!simFindPolicy(policyName) || levels > MAXPRIORITIES || numCpus > MAXCPUS)
+        return -1;
+    simSetPolicy(policyName);
+    simSetPriorities(levels);
+    simSetCpus(numCpus);
+    simSetBoost(opts->boost);
+    if (opts->reserve && pcbSlabReserve(opts->reserve)) {
+        pcbSlabRelease();
+        return -1;
+    }
+    return 0;
+}
+
+static simStatus finish(simStatus status, char flag, simResult *result) {
+    if (!result)
+        return status;
+    if (status == SIM_BADHANDLE) {
+        // the simulation of the thread, if any, is another session's: none of it goes in the result
+        memset(result, 0, sizeof(simResult));
+        result->status = status;
+        result->flag = flag;
+        return status;
+    }
+    result->status = status;
+    result->flag = flag;
+    result->pID = outcome.pID;
+    result->received = outcome.received;
+    result->from = outcome.from;
+    if (outcome.received)
+        memcpy(result->msg, outcome.msg, sizeof result->msg);
+    else
+        result->msg[0] = '\0';
+    // once "init" is killed, no process runs anymore
+    result->runningPID = run ? runningProc->pID : 0;
+    result->cpuID = run ? curCpu->id : 0;
+    result->clock = simClock;
+    result->over = !run;
+    return status;
+}
+
+// sink of sim_runWorkload(), stops the generation once the simulation is over
+static int execSink(const traceCmd *cmd, void *arg) {
+    sim_execCmd(arg, cmd, NULL);
+    return !run;
+}
+
+
+// |-------------------------------------------------------------------------|
+// |                          Implementation Definitions                     |
+// |-------------------------------------------------------------------------|
+
+simSession *sim_create(const simOptions *opts) {
+    simOptions defaults = {NULL, 0, 0, 0, 0, NULL};
+    simSession *session;
+
+    if (!opts)
+        opts = &defaults;
+    if (!(session = malloc(sizeof(simSession))))
+        return NULL;
+    if (!(session->state = simStateCreate())) {
+        free(session);
+        return NULL;
+    }
+    session->owner = &threadMark;
+    bindSession(session);
+    if (applyOptions(opts)) {
+        unbindSession();
+        simStateFree(session->state);
+        free(session);
+        return NULL;
+    }
+    quiet = !opts->reports;
+    reportFile = opts->reports;
+    simInit();
+    return session;
+}
+
+simStatus sim_exec(simSession *session, const char *line, simResult *result) {
+    traceCmd cmd;
+
+    if (bindSession(session))
+        return finish(SIM_BADHANDLE, 0, result);
+    if (traceParseLine(line, line + strlen(line), &cmd))
+        return finish(SIM_INVALID, 0, result);
+    return sim_execCmd(session, &cmd, result);
+}
+
+simStatus sim_execCmd(simSession *session, const traceCmd *cmd, simResult *result) {
+    if (bindSession(session))
+        return finish(SIM_BADHANDLE, cmd->flag, result);
+    outcome.pID = 0;
+    outcome.received = 0;
+    if (!run)
+        return finish(SIM_OVER, cmd->flag, result);
+    if (!cmd->flag || !strchr("CFKEQSRYNPVDITOALXU", cmd->flag))
+        return finish(SIM_INVALID, cmd->flag, result);
+    if (traceExec(cmd->flag, cmd->id, cmd->val, cmd->extra, (char *) cmd->msg))
+        return finish(SIM_REFUSED, cmd->flag, result);
+    return finish(SIM_OK, cmd->flag, result);
+}
+
+simStatus sim_runTrace(simSession *session, const char *path) {
+    if (bindSession(session))
+        return SIM_BADHANDLE;
+    if (!run)
+        return SIM_OVER;
+    return traceRun(path) ? SIM_INVALID : SIM_OK;
+}
+
+simStatus sim_replay(simSession *session, const traceCmds *cmds) {
+    if (bindSession(session))
+        return SIM_BADHANDLE;
+    if (!run)
+        return SIM_OVER;
+    traceReplay(cmds);
+    return SIM_OK;
+}
+
+simStatus sim_runWorkload(simSession *session, const workloadConfig *cfg) {
+    if (bindSession(session))
+        return SIM_BADHANDLE;
+    if (!run)
+        return SIM_OVER;
+    workloadGenerate(cfg, execSink, session);
+    return SIM_OK;
+}
+
+simStatus sim_query(simSession *session, simQueryKind kind, unsigned int id, simInfo *info) {
+    if (bindSession(session))
+        return SIM_BADHANDLE;
+    switch (kind) {
+        case SIM_QUERY_SYSTEM  : {
+            simSystemInfo *sys = &info->system;
+            sys->policy = policy->name;
+            sys->levels = numPriorities;
+            sys->cpus = numCpus;
+            sys->currentCpu = curCpu->id;
+            sys->runningPID = run ? runningProc->pID : 0;
+            sys->numProcs = numProcs;
+            sys->over = !run;
+            statsSummarize(&sys->totals);
+            return SIM_OK;
+        }
+        case SIM_QUERY_CPU  : {
+            simCpuInfo *aCpu = &info->cpu;
+            if (id >= numCpus)
+                return SIM_REFUSED;
+            aCpu->id = id;
+            aCpu->runningPID = run ? cpus[id].running->pID : 0;
+            aCpu->numReady = cpus[id].numReady;
+            aCpu->stats = cpus[id].stats;
+            return SIM_OK;
+        }
+        case SIM_QUERY_PROC  : {
+            simProcInfo *proc = &info->proc;
+            pcb *procFound = pidIndexFind(&procIndex, id);
+            if (!procFound)
+                return SIM_REFUSED;
+            syncProc(procFound);
+            proc->pID = procFound->pID;
+            proc->priority = procFound->priority;
+            proc->state = procFound->state;
+            if (procFound->queue == &waitingRcv)
+                proc->cause = BLOCKED_RCV;
+            else if (procFound->queue == &waitingReply)
+                proc->cause = BLOCKED_REPLY;
+            else
+                proc->cause = BLOCKED_SEM;
+            proc->cpuID = procFound->cpuID;
+            proc->running = procFound->state == RUNNING;
+            proc->realTime = EDFTASK(procFound);
+            proc->numMessages = mailboxCount(procFound->inbox);
+            proc->stats = procFound->stats;
+            return SIM_OK;
+        }
+    }
+    return SIM_REFUSED;
+}
+
+simStatus sim_printStats(simSession *session, FILE *out) {
+    if (bindSession(session))
+        return SIM_BADHANDLE;
+    statsPrintSummary(out);
+    return SIM_OK;
+}
+
+void sim_destroy(simSession *session) {
+    if (bindSession(session))
+        return;
+    simCleanup();
+    unbindSession();
+    simStateFree(session->state);
+    free(session);
+}
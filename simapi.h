@@ -0,0 +1,134 @@
+//// Embeddable simulator API
+//// Drives a simulation in-process: a test harness or a service opens a session with sim_create(), executes
+//// commands with sim_exec() (the syntax of a trace line, see trace.h) and gets a structured result back for each
+//// of them, replays whole traces or workloads, looks at processes, CPUs or the whole system with sim_query(),
+//// and closes the session with sim_destroy().
+//// Nothing is printed unless simOptions::reports names a stream for the reports of the commands: every message
+//// of a command, refusals and failures included, is one of its reports.
+////
+//// A session holds a whole simulation (see simState in sim.h). A thread can have any number of sessions open and
+//// use them in any order, each call acts on the session it is given; any number of threads can have sessions
+//// of their own. A session belongs to the thread that opened it: a call from another thread is refused with
+//// SIM_BADHANDLE. The event log (see evlog.h) belongs to the thread, its sessions all record into it.
+//// Nothing here changes the buffering of stdout, however much the reports written there.
+////
+//// Created on: Oct 16, 2026
+#pragma once
+
+#include <stdio.h>
+
+#include "sim.h"
+#include "trace.h"
+#include "workload.h"
+
+typedef struct simSession simSession;
+
+// configuration of a simulation, a zero field meaning the default
+typedef struct simOptions {
+    const char *policy;         // "mlfq" (NULL, the default), "rr", "fcfs" or "cfs"
+    unsigned int levels;        // priority levels, DEFAULTPRIORITIES by default
+    unsigned int cpus;          // simulated CPUs, 1 by default
+    unsigned int boost;         // quanta between two priority boosts, none by default
+    unsigned long reserve;      // processes to make room for up front (see pcbSlabReserve())
+    FILE *reports;              // stream the reports of the commands are written on, none by default
+} simOptions;
+
+typedef enum simStatus {
+    SIM_OK = 0,             // the command was carried out
+    SIM_REFUSED = -1,       // the simulator refused it (unknown process, nothing "init" may do...), or no such
+                            // process or CPU was queried
+    SIM_INVALID = -2,       // not a command, or its arguments are missing or out of range
+    SIM_OVER = -3,          // "init" was killed, the simulation is over: only sim_query(), sim_printStats() and
+                            // sim_destroy() are left
+    SIM_BADHANDLE = -4      // no session, or it belongs to another thread
+} simStatus;
+
+// what a command did
+typedef struct simResult {
+    simStatus status;
+    char flag;                  // command letter, upper case
+    unsigned int pID;           // process created by C, F or X
+    unsigned int runningPID;    // process running on the current CPU once the command is done
+    unsigned int cpuID;         // current CPU once the command is done
+    unsigned long clock;        // simClock once the command is done
+    int over;                   // set if the simulation is over once the command is done
+    int received;               // set if R received a message right away (else the process blocked)
+    unsigned int from;          // its sender
+    char msg[MAILBOXMSGSIZE];   // and its text
+} simResult;
+
+typedef enum simQueryKind {
+    SIM_QUERY_SYSTEM = 0,   // the whole simulation, id is ignored
+    SIM_QUERY_CPU,          // CPU id
+    SIM_QUERY_PROC          // process id
+} simQueryKind;
+
+typedef struct simProcInfo {
+    unsigned int pID;
+    unsigned int priority;
+    state state;
+    blockCause cause;           // why it is blocked, BLOCKED only
+    unsigned int cpuID;
+    int running;                // set if a CPU runs it
+    int realTime;               // set if it is a real-time task (see edf.h)
+    unsigned int numMessages;   // messages waiting to be received
+    procStats stats;
+} simProcInfo;
+
+typedef struct simCpuInfo {
+    unsigned int id;
+    unsigned int runningPID;
+    unsigned int numReady;      // processes in its ready set
+    cpuStats stats;
+} simCpuInfo;
+
+typedef struct simSystemInfo {
+    const char *policy;
+    unsigned int levels;
+    unsigned int cpus;
+    unsigned int currentCpu;
+    unsigned int runningPID;    // on the current CPU
+    unsigned int numProcs;      // besides "init"
+    int over;                   // set once "init" was killed
+    statsTotals totals;         // accounting of the processes that exited so far
+} simSystemInfo;
+
+typedef union simInfo {
+    simSystemInfo system;
+    simCpuInfo cpu;
+    simProcInfo proc;
+} simInfo;
+
+// opens a session for a new simulation owned by the calling thread, opts NULL for the defaults
+// returns NULL if opts is invalid or the simulation cannot be allocated
+simSession *sim_create(const simOptions *opts);
+
+// executes the command on line, e.g. "C", "K 3", "S 2 hello" or "X 10 8 2", and fills result (if not NULL)
+// returns result->status
+simStatus sim_exec(simSession *session, const char *line, simResult *result);
+
+// same with a command parsed already, e.g. by traceParseLine() or produced by a workload generator
+simStatus sim_execCmd(simSession *session, const traceCmd *cmd, simResult *result);
+
+// replays the trace at path (text or binary, see trace.h) until its end or the end of the simulation
+// returns SIM_OK, SIM_INVALID if the trace cannot be read or is corrupted, SIM_OVER, SIM_BADHANDLE
+simStatus sim_runTrace(simSession *session, const char *path);
+
+// replays cmds, e.g. loaded by traceLoad(), until their end or the end of the simulation
+// returns SIM_OK, SIM_OVER, SIM_BADHANDLE
+simStatus sim_replay(simSession *session, const traceCmds *cmds);
+
+// generates the workload of cfg (see workload.h) straight into the simulation
+// returns SIM_OK, SIM_OVER, SIM_BADHANDLE
+simStatus sim_runWorkload(simSession *session, const workloadConfig *cfg);
+
+// fills info->system, info->cpu or info->proc depending on kind
+// returns SIM_OK, SIM_REFUSED if there is no such CPU or process, SIM_BADHANDLE
+simStatus sim_query(simSession *session, simQueryKind kind, unsigned int id, simInfo *info);
+
+// prints the scheduling accounting summary of the simulation (see stats.h) on out
+// returns SIM_OK, SIM_BADHANDLE
+simStatus sim_printStats(simSession *session, FILE *out);
+
+// frees the simulation and everything left in it and closes the session
+void sim_destroy(simSession *session);
@@ -0,0 +1,462 @@
+//// Scheduling accounting
+//// See stats.h for the interface
+////
+//// Created on: Oct 16, 2026
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "sim.h"
+#include "stats.h"
+
+//-------------------------------------------------------------------------------------------------
+//---------------------------------- Data Structure Definitions -----------------------------------
+//-------------------------------------------------------------------------------------------------
+
+// log-linear histogram: values below HISTSUBBUCKETS get their own bucket, above that every power of two
+// is split into HISTSUBBUCKETS buckets, so a percentile is off by at most 1/HISTSUBBUCKETS (6%)
+#define HISTSUBBITS 4
+#define HISTSUBBUCKETS (1 << HISTSUBBITS)
+#define HISTNUMBUCKETS ((64 - HISTSUBBITS + 1) * HISTSUBBUCKETS)
+
+typedef struct histogram {
+    unsigned long count;
+    unsigned long long sum;
+    unsigned long max;
+    unsigned long buckets[HISTNUMBUCKETS];
+} histogram;
+
+// aggregates of the processes that exited at one priority level
+typedef struct priorityStats {
+    histogram wait;             // total time in the ready queues
+    histogram response;         // creation to first dispatch (processes that ran at least once)
+    histogram turnaround;       // creation to exit
+    unsigned long long blockedTime[STATSNUMCAUSES];
+    unsigned long long quanta[STATSQUANTALEVELS];
+} priorityStats;
+
+_Thread_local unsigned long simClock = 0;
+_Thread_local priorityStats *prioStats = NULL;    // one per priority level
+_Thread_local unsigned int numPrioStats = 0;
+_Thread_local unsigned long numExited = 0;
+// real-time jobs (see edf.h)
+_Thread_local unsigned long numJobs = 0;
+_Thread_local unsigned long numMisses = 0;
+_Thread_local long long latenessSum = 0;
+_Thread_local histogram tardiness;            // lateness of the jobs that missed their deadline
+
+// quanta a process that exited ran, kept under completely fair scheduling for the CPU shares
+typedef struct procShare {
+    unsigned int pID;
+    unsigned int priority;      // at exit, its nice value
+    unsigned long quanta;
+} procShare;
+
+_Thread_local procShare *exitedShares = NULL;
+_Thread_local unsigned long numExitedShares = 0;
+_Thread_local unsigned long exitedSharesCap = 0;
+
+struct statsState {
+    unsigned long simClock;
+    priorityStats *prioStats;
+    unsigned int numPrioStats;
+    unsigned long numExited;
+    unsigned long numJobs;
+    unsigned long numMisses;
+    long long latenessSum;
+    histogram tardiness;
+    procShare *exitedShares;
+    unsigned long numExitedShares;
+    unsigned long exitedSharesCap;
+};
+
+const char *causeNames[STATSNUMCAUSES] = {"semaphore", "waitingRcv", "waitingReply"};
+
+//-------------------------------------------------------------------------------------------------
+//---------------------------------- Helper Functions ---------------------------------------------
+//-------------------------------------------------------------------------------------------------
+
+static int bucketOf(unsigned long v) {
+    if (v < HISTSUBBUCKETS)
+        return (int) v;
+    int exponent = 63 - __builtin_clzll((unsigned long long) v);     // >= HISTSUBBITS
+    int sub = (int) ((v >> (exponent - HISTSUBBITS)) & (HISTSUBBUCKETS - 1));
+    return (exponent - HISTSUBBITS + 1) * HISTSUBBUCKETS + sub;
+}
+
+// smallest value falling in bucket
+static unsigned long bucketFloor(int bucket) {
+    if (bucket < HISTSUBBUCKETS)
+        return (unsigned long) bucket;
+    int exponent = bucket / HISTSUBBUCKETS + HISTSUBBITS - 1;
+    unsigned long sub = (unsigned long) (bucket % HISTSUBBUCKETS);
+    return (1UL << exponent) | (sub << (exponent - HISTSUBBITS));
+}
+
+static void histAdd(histogram *h, unsigned long v) {
+    h->count++;
+    h->sum += v;
+    if (v > h->max)
+        h->max = v;
+    h->buckets[bucketOf(v)]++;
+}
+
+// value at percentile pct (0-100), rounded down to its bucket
+static unsigned long histPercentile(const histogram *h, double pct) {
+    unsigned long rank = (unsigned long) (pct / 100.0 * (double) (h->count - 1));
+    unsigned long seen = 0;
+    int i;
+    for (i = 0; i < HISTNUMBUCKETS; i++) {
+        seen += h->buckets[i];
+        if (seen > rank)
+            return bucketFloor(i) < h->max ? bucketFloor(i) : h->max;
+    }
+    return h->max;
+}
+
+// adds every sample of src to dst
+static void histMerge(histogram *dst, const histogram *src) {
+    int i;
+    dst->count += src->count;
+    dst->sum += src->sum;
+    if (src->max > dst->max)
+        dst->max = src->max;
+    for (i = 0; i < HISTNUMBUCKETS; i++)
+        dst->buckets[i] += src->buckets[i];
+}
+
+static void histPrint(FILE *out, const char *name, const histogram *h) {
+    if (!h->count) {
+        fprintf(out, "\t%-11s no sample\n", name);
+        return;
+    }
+    fprintf(out, "\t%-11s mean %.1f  p50 %lu  p90 %lu  p99 %lu  max %lu\n", name, (double) h->sum / h->count,
+            histPercentile(h, 50), histPercentile(h, 90), histPercentile(h, 99), h->max);
+}
+
+// index in quanta[] of the quanta used at priority
+static unsigned int quantaLevel(unsigned int priority) {
+    return priority < STATSQUANTALEVELS ? priority : STATSQUANTALEVELS - 1;
+}
+
+// prints the priority levels quanta[] stands for, e.g. "0/1/2+"
+static void printQuantaLevels(FILE *out) {
+    unsigned int i;
+    for (i = 0; i < STATSQUANTALEVELS && i < numPrioStats; i++)
+        fprintf(out, "%s%u", i ? "/" : "", i);
+    if (numPrioStats > STATSQUANTALEVELS)
+        fputc('+', out);
+}
+
+// the CPU shares are only worth reporting when the weights of completely fair scheduling decide them
+static int fairShares() {
+    return policy && !strcmp(policy->name, "cfs");
+}
+
+// quanta a process ran, whatever the level it ran them at (the clock only advances on dispatches, so the run
+// time of a process is measured in quanta rather than in ticks)
+static unsigned long procQuanta(const procStats *st) {
+    unsigned long sum = 0;
+    int i;
+    for (i = 0; i < STATSQUANTALEVELS; i++)
+        sum += st->quanta[i];
+    return sum;
+}
+
+static void keepShare(unsigned int pID, unsigned int priority, unsigned long quanta) {
+    if (numExitedShares == exitedSharesCap) {
+        unsigned long newCap = exitedSharesCap ? exitedSharesCap * 2 : 64;
+        procShare *newShares = realloc(exitedShares, newCap * sizeof(procShare));
+        if (!newShares)     // that process is left out of the shares
+            return;
+        exitedShares = newShares;
+        exitedSharesCap = newCap;
+    }
+    exitedShares[numExitedShares++] = (procShare) {pID, priority, quanta};
+}
+
+static int comparePIDs(const void *a, const void *b) {
+    unsigned int x = *(const unsigned int *) a, y = *(const unsigned int *) b;
+    return x < y ? -1 : x > y;
+}
+
+// prints the share of the quanta each process ran, the live ones (by pID) then the exited ones (by exit)
+static void printShares(FILE *out) {
+    unsigned int states[] = {RUNNING, READY, BLOCKED};
+    unsigned long numLive = 0, kept = 0, i;
+    unsigned long long total = 0;
+    unsigned int *pIDs = malloc((numProcs + 1) * sizeof(unsigned int));
+    int s;
+
+    if (!pIDs)
+        return;
+    for (s = 0; s < 3; s++)
+        numLive += procTableFilter(PROCSTATE, states[s], pIDs + numLive, numProcs + 1 - numLive);
+    // "init" only runs when nothing else can, it has no share (once it is killed, it has left the table)
+    for (i = 0; i < numLive; i++) {
+        if (!run || pIDs[i] != proc_init->pID)
+            pIDs[kept++] = pIDs[i];
+    }
+    numLive = kept;
+    qsort(pIDs, numLive, sizeof(unsigned int), comparePIDs);
+    for (i = 0; i < numLive; i++)
+        total += procQuanta(&pidIndexFind(&procIndex, pIDs[i])->stats);
+    for (i = 0; i < numExitedShares; i++)
+        total += exitedShares[i].quanta;
+
+    fprintf(out, "--CPU share per process (nice: its priority, weight: see cfs.h)\n");
+    fprintf(out, "\t%10s %4s %6s %7s %6s\n", "pID", "nice", "weight", "quanta", "share");
+    for (i = 0; i < numLive; i++) {
+        const pcb *aProc = pidIndexFind(&procIndex, pIDs[i]);
+        unsigned long quanta = procQuanta(&aProc->stats);
+        fprintf(out, "\t%10u %4u %6u %7lu %5.1f%%\n", aProc->pID, aProc->priority, cfsWeight(aProc->priority),
+                quanta, total ? 100.0 * (double) quanta / total : 0.0);
+    }
+    for (i = 0; i < numExitedShares; i++) {
+        const procShare *ps = &exitedShares[i];
+        fprintf(out, "\t%10u %4u %6u %7lu %5.1f%% (exited)\n", ps->pID, ps->priority, cfsWeight(ps->priority),
+                ps->quanta, total ? 100.0 * (double) ps->quanta / total : 0.0);
+    }
+    free(pIDs);
+}
+
+// charges the time spent in the current state to the right counter
+static void closeState(procStats *st) {
+    unsigned long elapsed = simClock - st->lastChange;
+    switch (st->acctState) {
+        case READY:
+            st->readyWait += elapsed;
+            break;
+        case RUNNING:
+            st->runTime += elapsed;
+            break;
+        case BLOCKED:
+            st->blockedTime[st->blockedBy] += elapsed;
+            break;
+    }
+    st->lastChange = simClock;
+}
+
+//-------------------------------------------------------------------------------------------------
+//---------------------------------- Implementation Definitions ----------------------------------
+//-------------------------------------------------------------------------------------------------
+
+void statsOnCreate(procStats *st) {
+    memset(st, 0, sizeof(procStats));
+    st->createTime = simClock;
+    st->lastChange = simClock;
+    st->firstDispatch = STATSNEVER;
+    st->acctState = READY;
+}
+
+void statsOnReady(procStats *st) {
+    closeState(st);
+    st->acctState = READY;
+}
+
+void statsOnDispatch(procStats *st) {
+    closeState(st);
+    if (st->firstDispatch == STATSNEVER)
+        st->firstDispatch = simClock;
+    st->acctState = RUNNING;
+}
+
+void statsOnBlock(procStats *st, unsigned int cause) {
+    closeState(st);
+    st->acctState = BLOCKED;
+    st->blockedBy = (unsigned char) cause;
+}
+
+void statsOnQuantum(procStats *st, unsigned int priority) {
+    st->quanta[quantaLevel(priority)]++;
+}
+
+void statsOnExit(procStats *st, unsigned int pID, unsigned int priority) {
+    int i;
+    if (!numPrioStats)      // the aggregates could not be allocated
+        return;
+    if (priority >= numPrioStats)
+        priority = numPrioStats - 1;
+    closeState(st);
+    if (fairShares())
+        keepShare(pID, priority, procQuanta(st));
+    priorityStats *ps = &prioStats[priority];
+    histAdd(&ps->wait, st->readyWait);
+    if (st->firstDispatch != STATSNEVER)
+        histAdd(&ps->response, st->firstDispatch - st->createTime);
+    histAdd(&ps->turnaround, simClock - st->createTime);
+    for (i = 0; i < STATSNUMCAUSES; i++)
+        ps->blockedTime[i] += st->blockedTime[i];
+    for (i = 0; i < STATSQUANTALEVELS; i++)
+        ps->quanta[i] += st->quanta[i];
+    numExited++;
+}
+
+void statsOnJob(long lateness) {
+    numJobs++;
+    latenessSum += lateness;
+    if (lateness > 0) {
+        numMisses++;
+        histAdd(&tardiness, (unsigned long) lateness);
+    }
+}
+
+int statsReset() {
+    simClock = 0;
+    numExited = 0;
+    numJobs = numMisses = 0;
+    latenessSum = 0;
+    memset(&tardiness, 0, sizeof tardiness);
+    numExitedShares = 0;
+    free(prioStats);
+    numPrioStats = 0;
+    if (!(prioStats = calloc(numPriorities, sizeof(priorityStats))))
+        return -1;
+    numPrioStats = numPriorities;
+    return 0;
+}
+
+void statsFree() {
+    free(prioStats);
+    prioStats = NULL;
+    numPrioStats = 0;
+    free(exitedShares);
+    exitedShares = NULL;
+    numExitedShares = exitedSharesCap = 0;
+}
+
+statsState *statsStateCreate() {
+    return calloc(1, sizeof(statsState));
+}
+
+void statsSwap(statsState *state) {
+    SIMSWAP(simClock, state->simClock);
+    SIMSWAP(prioStats, state->prioStats);
+    SIMSWAP(numPrioStats, state->numPrioStats);
+    SIMSWAP(numExited, state->numExited);
+    SIMSWAP(numJobs, state->numJobs);
+    SIMSWAP(numMisses, state->numMisses);
+    SIMSWAP(latenessSum, state->latenessSum);
+    SIMSWAP(tardiness, state->tardiness);
+    SIMSWAP(exitedShares, state->exitedShares);
+    SIMSWAP(numExitedShares, state->numExitedShares);
+    SIMSWAP(exitedSharesCap, state->exitedSharesCap);
+}
+
+void statsPrintProc(FILE *out, const procStats *st) {
+    int i;
+    fprintf(out, "\tCreated at tick %lu, ", st->createTime);
+    if (st->firstDispatch == STATSNEVER)
+        fprintf(out, "never dispatched yet\n");
+    else
+        fprintf(out, "first dispatched at tick %lu (response time %lu)\n", st->firstDispatch,
+                st->firstDispatch - st->createTime);
+    // the time spent in the current state is not charged yet, add it for display
+    unsigned long current = simClock - st->lastChange;
+    fprintf(out, "\tReady queue wait: %lu, running: %lu", st->readyWait + (st->acctState == READY ? current : 0),
+            st->runTime + (st->acctState == RUNNING ? current : 0));
+    for (i = 0; i < STATSNUMCAUSES; i++)
+        fprintf(out, ", blocked (%s): %lu", causeNames[i],
+                st->blockedTime[i] + (st->acctState == BLOCKED && st->blockedBy == i ? current : 0));
+    fprintf(out, "\n\tQuanta used at priority ");
+    printQuantaLevels(out);
+    for (i = 0; i < STATSQUANTALEVELS && i < numPrioStats; i++)
+        fprintf(out, "%s%u", i ? "/" : ": ", st->quanta[i]);
+    fputc('\n', out);
+}
+
+void statsSummarize(statsTotals *totals) {
+    histogram wait, turnaround;
+    unsigned long long responseSum = 0;
+    unsigned long responseCount = 0;
+    int i;
+
+    memset(totals, 0, sizeof(statsTotals));
+    memset(&wait, 0, sizeof wait);
+    memset(&turnaround, 0, sizeof turnaround);
+    for (i = 0; i < numPrioStats; i++) {
+        histMerge(&wait, &prioStats[i].wait);
+        histMerge(&turnaround, &prioStats[i].turnaround);
+        responseSum += prioStats[i].response.sum;
+        responseCount += prioStats[i].response.count;
+    }
+    totals->ticks = simClock;
+    totals->exited = numExited;
+    if (wait.count) {
+        totals->waitMean = (double) wait.sum / wait.count;
+        totals->waitP99 = histPercentile(&wait, 99);
+        totals->turnaroundMean = (double) turnaround.sum / turnaround.count;
+        totals->turnaroundP99 = histPercentile(&turnaround, 99);
+    }
+    if (responseCount)
+        totals->responseMean = (double) responseSum / responseCount;
+    // the unfinished jobs past their deadline are misses already
+    long long unfinishedLateness = 0;
+    unsigned long unfinished = edfLateJobs(&unfinishedLateness);
+    totals->jobs = numJobs + unfinished;
+    totals->misses = numMisses + unfinished;
+    for (i = 0; cpus && i < numCpus; i++) {
+        totals->busyQuanta += cpus[i].stats.busyQuanta;
+        totals->idleQuanta += cpus[i].stats.idleQuanta;
+        totals->stealTries += cpus[i].stats.stealTries;
+        totals->steals += cpus[i].stats.steals;
+    }
+}
+
+void statsPrintSummary(FILE *out) {
+    int i, j;
+    fprintf(out, "--Scheduling accounting at tick %lu (%lu processes exited, processes still alive are not included)\n",
+            simClock, numExited);
+    for (i = 0; i < numPrioStats; i++) {
+        priorityStats *ps = &prioStats[i];
+        unsigned long n = ps->turnaround.count;
+        fprintf(out, "----Processes that exited at priority [%d]: %lu\n", i, n);
+        if (!n)
+            continue;
+        histPrint(out, "wait", &ps->wait);
+        histPrint(out, "response", &ps->response);
+        histPrint(out, "turnaround", &ps->turnaround);
+        fprintf(out, "\t%-11s", "blocked");
+        for (j = 0; j < STATSNUMCAUSES; j++)
+            fprintf(out, " %s %.1f ", causeNames[j], (double) ps->blockedTime[j] / n);
+        fprintf(out, "(mean ticks)\n\t%-11s", "quanta");
+        for (j = 0; j < STATSQUANTALEVELS && j < numPrioStats; j++)
+            fprintf(out, " at priority %d%s: %.2f ", j,
+                    j == STATSQUANTALEVELS - 1 && numPrioStats > STATSQUANTALEVELS ? "+" : "",
+                    (double) ps->quanta[j] / n);
+        fprintf(out, "(mean per process)\n");
+    }
+    if (fairShares())
+        printShares(out);
+    long long lateness = latenessSum;
+    unsigned long unfinished = edfLateJobs(&lateness);
+    unsigned long jobs = numJobs + unfinished, misses = numMisses + unfinished;
+    if (jobs) {
+        fprintf(out, "----Real-time jobs completed or past their deadline: %lu, deadline misses: %lu (%.1f%%), "
+                     "mean lateness %.1f ticks\n", jobs, misses, 100.0 * (double) misses / jobs,
+                (double) lateness / jobs);
+        if (unfinished)
+            fprintf(out, "\t%lu of the misses are jobs still unfinished, not in the tardiness below\n", unfinished);
+        histPrint(out, "tardiness", &tardiness);
+    }
+    if (numCpus > 1 && cpus) {
+        unsigned long stealTries = 0, steals = 0, rtMoves = 0;
+        fprintf(out, "--CPU accounting (%u CPUs)\n", numCpus);
+        for (i = 0; i < numCpus; i++) {
+            const cpuStats *cs = &cpus[i].stats;
+            unsigned long quanta = cs->busyQuanta + cs->idleQuanta;
+            fprintf(out, "----CPU #%d: utilization %.1f%% (%lu busy, %lu idle quanta), %lu dispatches, "
+                         "%lu of %lu steals succeeded, %lu processes stolen by other CPUs, "
+                         "%lu real-time tasks moved in\n", i,
+                    quanta ? 100.0 * (double) cs->busyQuanta / quanta : 0.0, cs->busyQuanta, cs->idleQuanta,
+                    cs->dispatches, cs->steals, cs->stealTries, cs->stolen, cs->rtMoves);
+            stealTries += cs->stealTries;
+            steals += cs->steals;
+            rtMoves += cs->rtMoves;
+        }
+        // every migration the event log records, EV_STEAL and EV_MIGRATE alike (see evlog.h)
+        fprintf(out, "----Load balancing: %lu migrations (%lu steals, %lu real-time task moves), "
+                     "steal success rate %.1f%% (%lu of %lu attempts)\n", steals + rtMoves, steals, rtMoves,
+                stealTries ? 100.0 * (double) steals / stealTries : 0.0, steals, stealTries);
+    }
+}
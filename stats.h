@@ -0,0 +1,101 @@
+//// Scheduling accounting
+//// A logical clock (simClock) advances by one tick on each dispatch, i.e. after every quantum and every
+//// time the running process blocks or dies. Each pcb carries a procStats that is updated incrementally
+//// at every state change (create, enqueue, dispatch, block, quantum, exit), the queues are never rescanned.
+//// When a process exits, its numbers are folded into per-priority aggregates (by the priority it exited at),
+//// which keep log-linear histograms so that percentiles can be reported at any time in constant memory.
+//// There is one aggregate per priority level of the simulation (numPriorities, see sim.h).
+////
+//// Created on: Oct 16, 2026
+#pragma once
+
+#include <stdio.h>
+
+#define STATSQUANTALEVELS 3     // quanta are counted per level for the top levels, the deeper ones share the last
+#define STATSNUMCAUSES 3    // one per blockCause in sim.h
+#define STATSNEVER ((unsigned long) -1)
+
+// per-process accounting, embedded in the pcb. All times are in ticks of simClock
+typedef struct procStats {
+    unsigned long createTime;
+    unsigned long firstDispatch;            // STATSNEVER until the process first runs
+    unsigned long lastChange;               // tick at which the process entered its current state
+    unsigned long readyWait;                // total time spent in the ready queues
+    unsigned long runTime;                  // total time spent running
+    unsigned long blockedTime[STATSNUMCAUSES];  // total time spent blocked, by cause
+    unsigned int quanta[STATSQUANTALEVELS];     // quanta used up at each of the top priority levels
+    unsigned char acctState;                // READY/RUNNING/BLOCKED as seen by the accounting
+    unsigned char blockedBy;                // blockCause of the current block
+} procStats;
+
+// per-CPU accounting, embedded in each simulated CPU (see cpu in sim.h)
+typedef struct cpuStats {
+    unsigned long busyQuanta;       // quanta used by a process
+    unsigned long idleQuanta;       // quanta spent running "init"
+    unsigned long dispatches;
+    unsigned long stealTries;       // dispatches that found the ready set of the CPU empty and looked elsewhere
+    unsigned long steals;           // of those, the ones that took a process from another CPU
+    unsigned long stolen;           // processes other CPUs took from this one
+    unsigned long rtMoves;          // real-time tasks last run elsewhere that this CPU dispatched (see edf.h)
+} cpuStats;
+
+extern _Thread_local unsigned long simClock;
+
+// advances the logical clock, called on every dispatch
+#define STATSTICK() (simClock++)
+
+void statsOnCreate(procStats *st);
+void statsOnReady(procStats *st);
+void statsOnDispatch(procStats *st);
+void statsOnBlock(procStats *st, unsigned int cause);
+void statsOnQuantum(procStats *st, unsigned int priority);
+void statsOnExit(procStats *st, unsigned int pID, unsigned int priority);
+
+// accounts a real-time job (see edf.h) that completed, or was abandoned past its deadline, lateness being the
+// tick it completed or was abandoned at minus its deadline
+void statsOnJob(long lateness);
+
+// headline numbers of a simulation: every process that exited so far folded together, whatever its priority,
+// and every CPU folded together
+typedef struct statsTotals {
+    unsigned long ticks;
+    unsigned long exited;
+    double waitMean;
+    unsigned long waitP99;
+    double responseMean;
+    double turnaroundMean;
+    unsigned long turnaroundP99;
+    unsigned long jobs;             // real-time jobs completed, or past their deadline without completing
+    unsigned long misses;           // of which missed their deadline (every unfinished one)
+    unsigned long busyQuanta;
+    unsigned long idleQuanta;
+    unsigned long stealTries;
+    unsigned long steals;
+} statsTotals;
+
+// fills totals from the accounting of the simulation
+void statsSummarize(statsTotals *totals);
+
+// clears the clock and every aggregate, sized for numPriorities levels
+// returns 0 on success, -1 if the aggregates cannot be allocated
+int statsReset();
+
+// frees the aggregates, statsReset() sets them up again
+void statsFree();
+
+// the clock and accounting of a simulation kept aside (see simSwap() in sim.h)
+typedef struct statsState statsState;
+
+// allocates the state of a simulation with a clock at 0 and no aggregate, NULL if it cannot be allocated
+statsState *statsStateCreate();
+
+// exchanges the clock and accounting of the thread with the ones kept in state
+void statsSwap(statsState *state);
+
+// prints the accounting of one process
+void statsPrintProc(FILE *out, const procStats *st);
+
+// prints the per-priority aggregates of every process that exited so far, under completely fair scheduling
+// the share of the run time each process got so far, live or exited, then the accounting of each CPU if there
+// are several
+void statsPrintSummary(FILE *out);
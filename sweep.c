@@ -0,0 +1,359 @@
+//// Parallel parameter sweep
+//// See sweep.h for the interface
+////
+//// Created on: Oct 16, 2026
+
+#define _POSIX_C_SOURCE 200809L     // sysconf() and clock_gettime() under -std=c11
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <limits.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <stdatomic.h>
+
+#include "sweep.h"
+
+#define SWEEPMAXTHREADS 1024
+
+// one combination of the swept values and what its simulation measured
+typedef struct sweepResult {
+    const char *policy;
+    unsigned int levels;
+    unsigned int boost;
+    unsigned int cpus;
+    unsigned int seedIndex;
+    unsigned int workload;          // index of the workload replayed
+    int failed;                     // set if its simulation could not be created
+    statsTotals totals;
+    double seconds;
+} sweepResult;
+
+// shared by the threads of a sweep. The workloads are written before the threads start and only read after,
+// each result is written by the one thread that took its run
+typedef struct sweepJobs {
+    const traceCmds *workloads;     // see numWorkloads()
+    sweepResult *results;
+    unsigned long numRuns;
+    atomic_ulong nextRun;           // next run to be taken by a thread
+} sweepJobs;
+
+
+// |-------------------------------------------------------------------------|
+// |                          Helper Functions                               |
+// |-------------------------------------------------------------------------|
+
+static double now() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double) ts.tv_sec + (double) ts.tv_nsec * 1e-9;
+}
+
+// parses the comma separated values of a list option, a value being n or a range n-m
+// returns the number of values, -1 if one is invalid, above max or too many
+static int parseList(const char *value, unsigned long long max, unsigned long long *values) {
+    int count = 0;
+    char *endptr;
+
+    for (;;) {
+        unsigned long long first, last;
+        errno = 0;
+        if (*value == '-')
+            return -1;
+        first = last = strtoull(value, &endptr, 0);
+        if (*endptr == '-') {
+            value = endptr + 1;
+            if (*value == '-')
+                return -1;
+            last = strtoull(value, &endptr, 0);
+        }
+        if (errno || endptr == value || first > last || last > max
+            || last - first >= SWEEPMAXVALUES - (unsigned long long) count)
+            return -1;
+        while (first <= last) {
+            values[count++] = first;
+            if (first++ == last)    // last may be the largest value there is
+                break;
+        }
+        if (*endptr == '\0')
+            return count;
+        if (*endptr != ',')
+            return -1;
+        value = endptr + 1;
+    }
+}
+
+// parses the comma separated policy names of value into cfg->policies
+static int parsePolicies(sweepConfig *cfg, const char *value) {
+    const char *names[SWEEPMAXVALUES];
+    unsigned int count = 0;
+
+    while (count < SWEEPMAXVALUES) {
+        const char *end = strchr(value, ',');
+        size_t len = end ? (size_t) (end - value) : strlen(value);
+        const schedPolicy *found;
+        char name[32];
+        if (len == 0 || len >= sizeof name)
+            return -1;
+        memcpy(name, value, len);
+        name[len] = '\0';
+        if (!(found = simFindPolicy(name)))
+            return -1;
+        names[count++] = found->name;
+        if (!end) {
+            memcpy(cfg->policies, names, count * sizeof names[0]);
+            cfg->numPolicies = count;
+            return 0;
+        }
+        value = end + 1;
+    }
+    return -1;
+}
+
+// a generated workload is generated per seed, and per CPU count if its U commands pick from the CPUs
+static unsigned int numWorkloads(const sweepConfig *cfg) {
+    if (cfg->tracePath)
+        return 1;
+    return cfg->numSeeds * (cfg->workload.cpuWeight ? cfg->numCpuCounts : 1);
+}
+
+static unsigned int workloadIndex(const sweepConfig *cfg, unsigned int seedIndex, unsigned int cpuIndex) {
+    if (cfg->tracePath)
+        return 0;
+    return cfg->workload.cpuWeight ? seedIndex * cfg->numCpuCounts + cpuIndex : seedIndex;
+}
+
+static int addCmd(const traceCmd *cmd, void *arg) {
+    return traceCmdsAdd(arg, cmd);
+}
+
+// loads the trace, or generates the workloads
+static int loadWorkloads(const sweepConfig *cfg, traceCmds *workloads) {
+    unsigned int s, c;
+
+    if (cfg->tracePath)
+        return traceLoad(cfg->tracePath, &workloads[0]);
+    for (s = 0; s < cfg->numSeeds; s++) {
+        for (c = 0; c < (cfg->workload.cpuWeight ? cfg->numCpuCounts : 1); c++) {
+            traceCmds *cmds = &workloads[workloadIndex(cfg, s, c)];
+            workloadConfig wl = cfg->workload;
+            wl.seed = cfg->seeds[s];
+            wl.numCpus = cfg->cpus[c];
+            if (workloadGenerate(&wl, addCmd, cmds) != cmds->count) {
+                fprintf(stderr, "Out of memory generating the workload of seed %llu\n",
+                        (unsigned long long) cfg->seeds[s]);
+                return -1;
+            }
+        }
+    }
+    return 0;
+}
+
+// only the multi-level feedback queue boosts priorities, the other policies are run once, without boost,
+// whatever the boosts swept
+static int boosted(const char *policyName) {
+    return !strcmp(policyName, "mlfq");
+}
+
+static unsigned int numBoostsOf(const sweepConfig *cfg, const char *policyName) {
+    return boosted(policyName) ? cfg->numBoosts : 1;
+}
+
+static unsigned long numRuns(const sweepConfig *cfg) {
+    unsigned long runs = 0;
+    unsigned int p;
+
+    for (p = 0; p < cfg->numPolicies; p++)
+        runs += numBoostsOf(cfg, cfg->policies[p]);
+    return runs * cfg->numLevels * cfg->numCpuCounts * (cfg->tracePath ? 1 : cfg->numSeeds);
+}
+
+// lays out the runs, seeds varying fastest and policies slowest, as the table lists them
+static void layoutRuns(const sweepConfig *cfg, sweepResult *results) {
+    unsigned int p, l, b, c, s;
+    unsigned int numSeeds = cfg->tracePath ? 1 : cfg->numSeeds;
+
+    for (p = 0; p < cfg->numPolicies; p++)
+        for (l = 0; l < cfg->numLevels; l++)
+            for (b = 0; b < numBoostsOf(cfg, cfg->policies[p]); b++)
+                for (c = 0; c < cfg->numCpuCounts; c++)
+                    for (s = 0; s < numSeeds; s++)
+                        *results++ = (sweepResult) {.policy = cfg->policies[p], .levels = cfg->levels[l],
+                                                    .boost = boosted(cfg->policies[p]) ? cfg->boosts[b] : 0,
+                                                    .cpus = cfg->cpus[c], .seedIndex = s,
+                                                    .workload = workloadIndex(cfg, s, c)};
+}
+
+// takes runs until there are none left, each simulated by a quiet session of the thread's own
+static void *sweepWorker(void *arg) {
+    sweepJobs *jobs = arg;
+    unsigned long i;
+
+    while ((i = atomic_fetch_add(&jobs->nextRun, 1)) < jobs->numRuns) {
+        sweepResult *result = &jobs->results[i];
+        simOptions opts = {result->policy, result->levels, result->cpus, result->boost, 0, NULL};
+        simInfo info;
+        double start = now();
+        simSession *sim = sim_create(&opts);
+        // reported in the table, a line on stderr would interleave with those of the other threads
+        if (!sim) {
+            result->failed = 1;
+            continue;
+        }
+        sim_replay(sim, &jobs->workloads[result->workload]);
+        sim_query(sim, SIM_QUERY_SYSTEM, 0, &info);
+        result->totals = info.system.totals;
+        sim_destroy(sim);
+        result->seconds = now() - start;
+    }
+    return NULL;
+}
+
+static void printResult(FILE *out, const sweepConfig *cfg, const sweepJobs *jobs, const sweepResult *result) {
+    const statsTotals *t = &result->totals;
+    unsigned long quanta = t->busyQuanta + t->idleQuanta;
+
+    fprintf(out, "%s,%u,", result->policy, result->levels);
+    if (boosted(result->policy))
+        fprintf(out, "%u", result->boost);
+    fprintf(out, ",%u,", result->cpus);
+    if (!cfg->tracePath)
+        fprintf(out, "%llu", (unsigned long long) cfg->seeds[result->seedIndex]);
+    fprintf(out, ",%zu,", jobs->workloads[result->workload].count);
+    if (result->failed) {
+        fputs(",,,,,,,,,,,,failed\n", out);
+        return;
+    }
+    fprintf(out, "%lu,%lu,%.1f,%lu,%.1f,%.1f,%lu,%lu,%lu,%.1f,%.1f,%.6f,ok\n",
+            t->ticks, t->exited, t->waitMean, t->waitP99,
+            t->responseMean, t->turnaroundMean, t->turnaroundP99, t->jobs, t->misses,
+            quanta ? 100.0 * t->busyQuanta / quanta : 0.0,
+            t->stealTries ? 100.0 * t->steals / t->stealTries : 0.0, result->seconds);
+}
+
+
+// |-------------------------------------------------------------------------|
+// |                          Implementation Definitions                     |
+// |-------------------------------------------------------------------------|
+
+void sweepDefaults(sweepConfig *cfg, const simOptions *opts) {
+    const schedPolicy *found = simFindPolicy(opts && opts->policy ? opts->policy : "mlfq");
+
+    memset(cfg, 0, sizeof *cfg);
+    workloadDefaults(&cfg->workload);
+    cfg->policies[0] = found ? found->name : "mlfq";
+    cfg->numPolicies = 1;
+    cfg->levels[0] = opts && opts->levels ? opts->levels : DEFAULTPRIORITIES;
+    cfg->numLevels = 1;
+    cfg->boosts[0] = opts ? opts->boost : 0;
+    cfg->numBoosts = 1;
+    cfg->cpus[0] = opts && opts->cpus ? opts->cpus : 1;
+    cfg->numCpuCounts = 1;
+    cfg->seeds[0] = cfg->workload.seed;
+    cfg->numSeeds = 1;
+}
+
+int sweepSetOption(sweepConfig *cfg, const char *option) {
+    const char *value = strchr(option, '=');
+    unsigned long long values[SWEEPMAXVALUES];
+    size_t keyLen;
+    int count, i;
+
+    if (!value || value[1] == '\0')
+        return -1;
+    keyLen = (size_t) (value - option);
+    value++;
+    if (keyLen == 6 && !strncmp(option, "policy", keyLen))
+        return parsePolicies(cfg, value);
+
+#define LIST(name, field, countField, zeroAllowed, max) \
+    if (keyLen == sizeof(name) - 1 && !strncmp(option, name, keyLen)) { \
+        if ((count = parseList(value, max, values)) < 0) return -1; \
+        for (i = 0; i < count; i++) { \
+            if (!values[i] && !(zeroAllowed)) return -1; \
+            cfg->field[i] = values[i]; \
+        } \
+        cfg->countField = count; \
+        return 0; \
+    }
+    LIST("levels", levels, numLevels, 0, MAXPRIORITIES)
+    LIST("boost", boosts, numBoosts, 1, UINT_MAX)
+    LIST("cpus", cpus, numCpuCounts, 0, MAXCPUS)
+    LIST("seed", seeds, numSeeds, 1, UINT64_MAX)
+#undef LIST
+
+    if (keyLen == 7 && !strncmp(option, "threads", keyLen)) {
+        if (parseList(value, SWEEPMAXTHREADS, values) != 1)
+            return -1;
+        cfg->numThreads = values[0];
+        return 0;
+    }
+    return workloadSetOption(&cfg->workload, option);
+}
+
+int sweepRun(const sweepConfig *cfg, FILE *out) {
+    unsigned int numLoaded = numWorkloads(cfg);
+    unsigned long numThreads = cfg->numThreads;
+    unsigned long i, started;
+    int status = -1;
+    pthread_t *threads = NULL;
+    sweepJobs jobs;
+
+    jobs.numRuns = numRuns(cfg);
+    atomic_init(&jobs.nextRun, 0);
+    traceCmds *workloads = calloc(numLoaded, sizeof(traceCmds));
+    jobs.workloads = workloads;
+    jobs.results = calloc(jobs.numRuns, sizeof(sweepResult));
+    if (!workloads || !jobs.results) {
+        fprintf(stderr, "Out of memory setting up the sweep\n");
+        goto done;
+    }
+    if (loadWorkloads(cfg, workloads))
+        goto done;
+    layoutRuns(cfg, jobs.results);
+
+    if (!numThreads) {
+        long online = sysconf(_SC_NPROCESSORS_ONLN);
+        numThreads = online > 0 ? online : 1;
+    }
+    if (numThreads > jobs.numRuns)
+        numThreads = jobs.numRuns;
+    if (!(threads = malloc(numThreads * sizeof(pthread_t)))) {
+        fprintf(stderr, "Out of memory setting up the sweep\n");
+        goto done;
+    }
+    // the runs are shared by whichever threads could be started
+    for (started = 0; started < numThreads; started++) {
+        if (pthread_create(&threads[started], NULL, sweepWorker, &jobs))
+            break;
+    }
+    if (!started) {
+        fprintf(stderr, "Could not start the sweep threads\n");
+        goto done;
+    }
+    for (i = 0; i < started; i++)
+        pthread_join(threads[i], NULL);
+
+    fprintf(out, "policy,levels,boost,cpus,seed,cmds,ticks,exited,wait_mean,wait_p99,response_mean,"
+                 "turnaround_mean,turnaround_p99,rt_jobs,rt_misses,utilization,steal_rate,seconds,status\n");
+    status = 0;
+    for (i = 0; i < jobs.numRuns; i++) {
+        printResult(out, cfg, &jobs, &jobs.results[i]);
+        if (jobs.results[i].failed)
+            status = -1;
+    }
+    fflush(out);
+
+done:
+    free(threads);
+    if (workloads) {
+        for (i = 0; i < numLoaded; i++)
+            free(workloads[i].cmds);
+    }
+    free(workloads);
+    free(jobs.results);
+    return status;
+}
@@ -0,0 +1,52 @@
+//// Parallel parameter sweep
+//// Replays one workload under many simulator configurations at once: every combination of the swept values
+//// (policy, priority levels, boost interval, number of CPUs, and the seed of a generated workload) is one run,
+//// the boost intervals only being crossed with "mlfq", the one policy that boosts (the others are run once,
+//// their boost left empty), and the runs are spread over a pool of threads, each running its own simulation (a session each,
+//// see simapi.h). The workload is loaded once, or generated once per seed (and per number of CPUs
+//// if it switches CPUs, see workloadConfig::cpuWeight), and shared read-only by every run. Each run is quiet,
+//// and its headline numbers (see statsTotals in stats.h) make one line of a single CSV table, in the order of
+//// the combinations whatever the order the runs complete in:
+////     policy,levels,boost,cpus,seed,cmds,ticks,exited,wait_mean,wait_p99,response_mean,turnaround_mean,
+////     turnaround_p99,rt_jobs,rt_misses,utilization,steal_rate,seconds,status
+//// status is "ok", or "failed" with no numbers if the simulation of the run could not be created.
+////
+//// Created on: Oct 16, 2026
+#pragma once
+
+#include <stdio.h>
+#include <stdint.h>
+
+#include "workload.h"
+#include "simapi.h"
+
+#define SWEEPMAXVALUES 64       // values a key can take in one sweep
+
+typedef struct sweepConfig {
+    const char *tracePath;          // workload replayed by every run, NULL: generated from workload
+    workloadConfig workload;        // its seed is replaced by each of seeds
+    unsigned int numThreads;        // 0: one per online host CPU
+    // swept values, every combination is run
+    const char *policies[SWEEPMAXVALUES];
+    unsigned int numPolicies;
+    unsigned int levels[SWEEPMAXVALUES];
+    unsigned int numLevels;
+    unsigned int boosts[SWEEPMAXVALUES];
+    unsigned int numBoosts;
+    unsigned int cpus[SWEEPMAXVALUES];
+    unsigned int numCpuCounts;
+    uint64_t seeds[SWEEPMAXVALUES];     // generated workloads only
+    unsigned int numSeeds;
+} sweepConfig;
+
+// fills cfg with one value per key, those of opts (NULL: the defaults), and the default workload
+void sweepDefaults(sweepConfig *cfg, const simOptions *opts);
+
+// sets one option given as "key=value,value,...": threads=n, or the values of policy, levels, boost, cpus or seed
+// anything else is a workload option (see workloadSetOption()), applying to generated workloads
+// returns 0 on success, -1 on unknown key or invalid value
+int sweepSetOption(sweepConfig *cfg, const char *option);
+
+// runs every combination and prints the table on out
+// returns 0 on success, -1 if the workload could not be loaded, the threads could not be started or a run failed
+int sweepRun(const sweepConfig *cfg, FILE *out);
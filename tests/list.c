@@ -0,0 +1,123 @@
+//// Exercises the List ADT, built against LIST.c in the build mode it was compiled for (see "Build modes" in
+//// LIST.h): "make test" runs it against the checked and the release builds
+//// Prints every failed check and exits 1 if there is any
+////
+//// Created on: Oct 16, 2026
+
+#include <stdio.h>
+
+#include "../LIST.h"
+
+#define MANYITEMS 10000     // more than a chunk of nodes, so that the pool has to grow
+
+static int failures = 0;
+
+#define CHECK(cond) do { if (!(cond)) { printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond); failures++; } } while (0)
+
+static int items[MANYITEMS];
+
+static int equals(void *item, void *arg) {
+    return *(int *) item == *(int *) arg;
+}
+
+static int freed = 0;
+
+static void countFree(void *item) {
+    freed++;
+}
+
+// the items of aList from head to tail must be want[0..n), and its count n
+static void checkItems(list *aList, const int *want, int n) {
+    int i = 0;
+    void *item;
+
+    CHECK(ListCount(aList) == n);
+    for (item = ListFirst(aList); item && i < n; item = ListNext(aList), i++)
+        CHECK(*(int *) item == want[i]);
+    CHECK(i == n && !item);
+}
+
+int main() {
+    int i;
+    list *a, *b;
+
+    for (i = 0; i < MANYITEMS; i++)
+        items[i] = i;
+
+    // building a list in every way there is
+    CHECK((a = ListCreate()) != NULL);
+    CHECK(ListCount(a) == 0 && !ListFirst(a) && !ListNext(a) && !ListPrev(a) && !ListCurr(a));
+    CHECK(ListAppend(a, &items[2]) == 0);
+    CHECK(ListPrepend(a, &items[0]) == 0);
+    CHECK(ListAdd(a, &items[1]) == 0);          // after the head, the current item
+    CHECK(ListLast(a) == &items[2]);
+    CHECK(ListAdd(a, &items[4]) == 0);          // after the tail
+    CHECK(ListInsert(a, &items[3]) == 0);       // before it
+    checkItems(a, (int[]) {0, 1, 2, 3, 4}, 5);
+
+    // moving past either end and back
+    CHECK(ListLast(a) == &items[4]);
+    CHECK(!ListNext(a) && !ListNext(a) && !ListCurr(a));
+    CHECK(ListPrev(a) == &items[4]);
+    CHECK(ListFirst(a) == &items[0]);
+    CHECK(!ListPrev(a) && !ListCurr(a));
+    CHECK(ListInsert(a, &items[5]) == 0);       // before the head
+    CHECK(ListCurr(a) == &items[5]);
+    CHECK(!ListPrev(a) && ListNext(a) == &items[5]);
+    CHECK(ListLast(a) == &items[4] && !ListNext(a));
+    CHECK(ListAdd(a, &items[6]) == 0);          // after the tail
+    checkItems(a, (int[]) {5, 0, 1, 2, 3, 4, 6}, 7);
+
+    // taking items out
+    CHECK(ListFirst(a) == &items[5] && ListRemove(a) == &items[5]);
+    CHECK(ListCurr(a) == &items[0]);
+    CHECK(ListNext(a) == &items[1] && ListRemove(a) == &items[1]);
+    CHECK(ListCurr(a) == &items[2]);
+    CHECK(ListTrim(a) == &items[6] && ListCurr(a) == &items[4]);
+    CHECK(ListRemove(a) == &items[4] && ListCurr(a) == &items[3]);
+    checkItems(a, (int[]) {0, 2, 3}, 3);
+
+    // searching from the head
+    CHECK(ListLast(a) && ListSearch(a, equals, &items[2]) == &items[2] && ListCurr(a) == &items[2]);
+    CHECK(!ListSearch(a, equals, &items[7]) && !ListCurr(a));
+    CHECK(ListPrev(a) == &items[3]);
+
+    // growing the node pool, then concatenating
+    CHECK((b = ListCreate()) != NULL);
+    for (i = 0; i < MANYITEMS; i++)
+        CHECK(ListAppend(b, &items[i]) == 0);
+    CHECK(ListCount(b) == MANYITEMS && ListLast(b) == &items[MANYITEMS - 1]);
+    CHECK(ListFirst(a) == &items[0]);
+    ListConcat(a, b);
+    CHECK(ListCount(a) == 3 + MANYITEMS && ListCurr(a) == &items[0]);
+    CHECK(ListLast(a) == &items[MANYITEMS - 1] && ListPrev(a) == &items[MANYITEMS - 2]);
+    CHECK(ListSearch(a, equals, &items[MANYITEMS / 2]) == &items[MANYITEMS / 2]);
+    CHECK(ListRemove(a) == &items[MANYITEMS / 2] && ListCurr(a) == &items[MANYITEMS / 2 + 1]);
+
+    // freeing gives every item to itemFree, and the list back to the pool
+    ListFree(a, countFree);
+    CHECK(freed == 2 + MANYITEMS);
+    CHECK((b = ListCreate()) == a);
+    CHECK(ListCount(b) == 0 && ListAppend(b, &items[0]) == 0);
+    checkItems(b, (int[]) {0}, 1);
+    CHECK(ListTrim(b) == &items[0] && !ListTrim(b) && !ListRemove(b) && !ListCurr(b));
+
+#ifndef LISTUNCHECKED
+    // the checked build refuses a freed list or one whose links do not belong to it
+    CHECK((a = ListCreate()) != NULL && ListAppend(a, &items[1]) == 0);
+    ListFree(b, countFree);
+    CHECK(ListCount(b) == -1 && ListAppend(b, &items[0]) == -1 && !ListFirst(b) && !ListRemove(b));
+    CHECK(ListCount(NULL) == -1 && ListAdd(NULL, &items[0]) == -1 && !ListNext(NULL));
+    CHECK((b = ListCreate()) != NULL && ListAppend(b, &items[2]) == 0);
+    b->curr = a->head;
+    CHECK(!ListNext(b) && !ListCurr(b) && ListAdd(b, &items[3]) == -1 && ListInsert(b, &items[3]) == -1);
+    CHECK(!ListRemove(b) && ListCount(a) == 1 && ListCount(b) == 1);
+    b->curr = b->head;
+    CHECK(ListCurr(b) == &items[2]);
+#endif
+
+    if (failures)
+        return 1;
+    puts("ok");
+    return 0;
+}
@@ -0,0 +1,122 @@
+//// Runs several sessions of the simulator API (see simapi.h) on one thread, interleaving their commands, and
+//// checks that each ends up where it ends up when run alone; then checks that a session is refused to any
+//// thread but its own, and that invalid options open no session
+//// Prints every failed check and exits 1 if there is any
+////
+//// Created on: Oct 16, 2026
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+
+#include "../simapi.h"
+
+#define NUMSESSIONS 3
+#define NUMCMDS 20000
+
+static int failures = 0;
+
+#define CHECK(cond) do { if (!(cond)) { printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond); failures++; } } while (0)
+
+static const simOptions options[NUMSESSIONS] = {
+        {NULL, 0, 0, 0, 0, NULL},
+        {"cfs", 0, 2, 0, 0, NULL},
+        {"mlfq", 5, 3, 4, 100, NULL},
+};
+
+// the generated commands of every session, and where each simulation ends up
+typedef struct sessionRun {
+    traceCmds cmds;
+    simSystemInfo info;
+} sessionRun;
+
+static sessionRun runs[NUMSESSIONS];
+
+static int collect(const traceCmd *cmd, void *arg) {
+    return traceCmdsAdd(arg, cmd);
+}
+
+static void checkSameInfo(const simSystemInfo *a, const simSystemInfo *b) {
+    CHECK(a->policy == b->policy && a->levels == b->levels && a->cpus == b->cpus);
+    CHECK(a->runningPID == b->runningPID && a->numProcs == b->numProcs && a->over == b->over);
+    CHECK(a->totals.ticks == b->totals.ticks && a->totals.exited == b->totals.exited);
+}
+
+static void *useElsewhere(void *arg) {
+    simSession *session = arg;
+    simInfo info;
+    simResult result;
+
+    CHECK(sim_exec(session, "C", &result) == SIM_BADHANDLE && result.status == SIM_BADHANDLE && !result.pID);
+    CHECK(sim_query(session, SIM_QUERY_SYSTEM, 0, &info) == SIM_BADHANDLE);
+    sim_destroy(session);       // refused too, the session stays open
+    return NULL;
+}
+
+int main() {
+    simSession *sessions[NUMSESSIONS];
+    simInfo info;
+    simResult result;
+    pthread_t thread;
+    size_t i;
+    int s;
+
+    // every session alone
+    for (s = 0; s < NUMSESSIONS; s++) {
+        workloadConfig cfg;
+        workloadDefaults(&cfg);
+        cfg.seed = s + 1;
+        cfg.numCmds = NUMCMDS;
+        cfg.cpuWeight = 5;
+        cfg.numCpus = options[s].cpus ? options[s].cpus : 1;
+        workloadGenerate(&cfg, collect, &runs[s].cmds);
+        CHECK((sessions[0] = sim_create(&options[s])) != NULL);
+        CHECK(sim_replay(sessions[0], &runs[s].cmds) == SIM_OK);
+        CHECK(sim_query(sessions[0], SIM_QUERY_SYSTEM, 0, &info) == SIM_OK);
+        runs[s].info = info.system;
+        sim_destroy(sessions[0]);
+    }
+
+    // all of them at once, one command of each in turn
+    for (s = 0; s < NUMSESSIONS; s++)
+        CHECK((sessions[s] = sim_create(&options[s])) != NULL);
+    for (i = 0; i < NUMCMDS; i++) {
+        for (s = 0; s < NUMSESSIONS; s++) {
+            if (i < runs[s].cmds.count)
+                sim_execCmd(sessions[s], &runs[s].cmds.cmds[i], NULL);
+        }
+    }
+    for (s = 0; s < NUMSESSIONS; s++) {
+        CHECK(sim_query(sessions[s], SIM_QUERY_SYSTEM, 0, &info) == SIM_OK);
+        checkSameInfo(&info.system, &runs[s].info);
+    }
+
+    // another thread cannot use them, nor close them
+    CHECK(pthread_create(&thread, NULL, useElsewhere, sessions[1]) == 0);
+    pthread_join(thread, NULL);
+    CHECK(sim_query(sessions[1], SIM_QUERY_SYSTEM, 0, &info) == SIM_OK);
+    checkSameInfo(&info.system, &runs[1].info);
+    CHECK(sim_exec(NULL, "C", &result) == SIM_BADHANDLE);
+
+    // closing one leaves the others as they were
+    sim_destroy(sessions[0]);
+    CHECK(sim_query(sessions[2], SIM_QUERY_SYSTEM, 0, &info) == SIM_OK);
+    checkSameInfo(&info.system, &runs[2].info);
+    sim_destroy(sessions[2]);
+    sim_destroy(sessions[1]);
+
+    // an invalid option is refused whatever its place, before any other is applied
+    CHECK(!sim_create(&(simOptions) {"mlfq", 0, MAXCPUS + 1, 0, 0, NULL}));
+    CHECK(!sim_create(&(simOptions) {"none", 4, 2, 0, 0, NULL}));
+    CHECK((sessions[0] = sim_create(NULL)) != NULL);
+    CHECK(sim_query(sessions[0], SIM_QUERY_SYSTEM, 0, &info) == SIM_OK);
+    CHECK(info.system.levels == DEFAULTPRIORITIES && info.system.cpus == 1);
+    sim_destroy(sessions[0]);
+
+    for (s = 0; s < NUMSESSIONS; s++)
+        free(runs[s].cmds.cmds);
+    if (failures)
+        return 1;
+    puts("ok");
+    return 0;
+}
@@ -0,0 +1,71 @@
+//// Runs generated workloads in-process and checks the generator's K targets against the simulator once it
+//// recycles pIDs (see pidindex.h): with no E in the mix the generator knows every process that dies, so
+//// past the first recycled pID every K must still hit a live process
+//// Prints every failed check and exits 1 if there is any
+////
+//// Created on: Oct 16, 2026
+
+#include <stdio.h>
+
+#include "../simapi.h"
+
+static int failures = 0;
+
+#define CHECK(cond) do { if (!(cond)) { printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond); failures++; } } while (0)
+
+// K commands and their misses, counted once a C or F got a recycled pID
+typedef struct killCount {
+    simSession *session;
+    int recycled;
+    unsigned long kills;
+    unsigned long missed;
+} killCount;
+
+static int countSink(const traceCmd *cmd, void *arg) {
+    killCount *count = arg;
+    simResult result;
+    simStatus status = sim_execCmd(count->session, cmd, &result);
+
+    if ((cmd->flag == 'C' || cmd->flag == 'F') && status == SIM_OK && result.pID >> PIDSLOTBITS)
+        count->recycled = 1;
+    if (cmd->flag == 'K' && count->recycled) {
+        count->kills++;
+        count->missed += status != SIM_OK;
+    }
+    return result.over;
+}
+
+// generates the workload given by options into a fresh session
+static void runWorkload(const char **options, int numOptions, killCount *count) {
+    workloadConfig cfg;
+    int i;
+
+    workloadDefaults(&cfg);
+    for (i = 0; i < numOptions; i++)
+        CHECK(workloadSetOption(&cfg, options[i]) == 0);
+    CHECK((count->session = sim_create(NULL)) != NULL);
+    if (!count->session)
+        return;
+    workloadGenerate(&cfg, countSink, count);
+    sim_destroy(count->session);
+}
+
+int main() {
+    killCount count = {NULL, 0, 0, 0};
+    killCount manyFrees = {NULL, 0, 0, 0};
+
+    // a few thousand frees past the reuse delay, every K of them on a live process
+    runWorkload((const char *[]) {"seed=1", "cmds=30000", "exit=0"}, 3, &count);
+    CHECK(count.recycled && count.kills > 1000);
+    CHECK(count.missed == 0);
+
+    // same with forks, and a pID space wrapped many times over
+    runWorkload((const char *[]) {"seed=9", "cmds=300000", "exit=0", "fork=20", "kill=30"}, 5, &manyFrees);
+    CHECK(manyFrees.recycled && manyFrees.kills > 50000);
+    CHECK(manyFrees.missed == 0);
+
+    if (failures)
+        return 1;
+    puts("ok");
+    return 0;
+}
@@ -0,0 +1,525 @@
+//// Batch replay of command traces
+//// See trace.h for the trace syntax
+////
+//// Created on: Oct 16, 2026
+
+#define _POSIX_C_SOURCE 200809L     // mmap(), fstat(), posix_madvise() with -std=c11
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <ctype.h>	// toupper()
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "sim.h"
+#include "trace.h"
+
+
+// |-------------------------------------------------------------------------|
+// |                          Helper Functions                               |
+// |-------------------------------------------------------------------------|
+
+// skips spaces and tabs
+static const char *skipBlanks(const char *p, const char *end) {
+    while (p < end && (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\v' || *p == '\f'))
+        p++;
+    return p;
+}
+
+// parses a decimal int at *p (an optional '-' is only accepted if allowNegative) and advances *p past it
+// the number must be followed by whitespace or the end of line
+// returns 0 on success, -1 on failure
+static int parseInt(const char **p, const char *end, int allowNegative, int *out) {
+    const char *q = *p;
+    int negative = 0;
+    long l = 0;
+
+    if (allowNegative && q < end && *q == '-') {
+        negative = 1;
+        q++;
+    }
+    if (q >= end || *q < '0' || *q > '9')
+        return -1;
+    while (q < end && *q >= '0' && *q <= '9') {
+        l = l * 10 + (*q++ - '0');
+        if (l > (long) INT_MAX + 1)
+            return -1;
+    }
+    if (q < end && !isspace((unsigned char) *q))
+        return -1;
+    if (negative)
+        l = -l;
+    if (l < INT_MIN || l > INT_MAX)
+        return -1;
+    *out = (int) l;
+    *p = q;
+    return 0;
+}
+
+// |-------------------------------------------------------------------------|
+// |                          Trace Implementations                          |
+// |-------------------------------------------------------------------------|
+
+int traceParseLine(const char *line, const char *end, traceCmd *cmd) {
+    const char *p = skipBlanks(line, end);
+    int num;
+
+    if (p == end || *p == '#')
+        return 1;
+    cmd->flag = (char) toupper((unsigned char) *p++);
+    cmd->id = 0;
+    cmd->val = 0;
+    cmd->extra = 0;
+    // the flag is exactly one char
+    if (p < end && !isspace((unsigned char) *p))
+        return -1;
+    p = skipBlanks(p, end);
+
+    switch (cmd->flag) {
+        case 'C':
+        case 'F':
+        case 'E':
+        case 'Q':
+        case 'T':
+        case 'O':
+        case 'A':
+            return 0;
+        case 'K':
+        case 'I':
+        case 'P':
+        case 'V':
+        case 'D':
+        case 'U':
+            if (parseInt(&p, end, 0, &num))
+                return -1;
+            cmd->id = (unsigned int) num;
+            return 0;
+        case 'R':
+            // the sender is optional, val tells whether one was given
+            if (p == end)
+                return 0;
+            if (parseInt(&p, end, 0, &num))
+                return -1;
+            cmd->id = (unsigned int) num;
+            cmd->val = 1;
+            return 0;
+        case 'S':
+        case 'Y': {
+            if (parseInt(&p, end, 0, &num))
+                return -1;
+            cmd->id = (unsigned int) num;
+            // the message is everything after the pID, without the trailing whitespace
+            p = skipBlanks(p, end);
+            const char *msgEnd = end;
+            while (msgEnd > p && isspace((unsigned char) msgEnd[-1]))
+                msgEnd--;
+            if (msgEnd == p)
+                return -1;
+            // messages are 40 char max, the rest is cut off
+            size_t msgLen = (size_t) (msgEnd - p) < TRACEMSGSIZE - 1 ? (size_t) (msgEnd - p) : TRACEMSGSIZE - 1;
+            memcpy(cmd->msg, p, msgLen);
+            cmd->msg[msgLen] = '\0';
+            return 0;
+        }
+        case 'N':
+        case 'L':
+            if (parseInt(&p, end, 0, &num))
+                return -1;
+            cmd->id = (unsigned int) num;
+            p = skipBlanks(p, end);
+            // only semaphore values can be negative
+            if (parseInt(&p, end, cmd->flag == 'N', &cmd->val))
+                return -1;
+            return 0;
+        case 'X':
+            if (parseInt(&p, end, 0, &num))
+                return -1;
+            cmd->id = (unsigned int) num;
+            p = skipBlanks(p, end);
+            if (parseInt(&p, end, 0, &cmd->val))
+                return -1;
+            p = skipBlanks(p, end);
+            if (parseInt(&p, end, 0, &num))
+                return -1;
+            cmd->extra = (unsigned int) num;
+            return 0;
+        default:
+            return -1;
+    }
+}
+
+int traceExec(char flag, unsigned int id, int val, unsigned int extra, char *msg) {
+    switch (flag) {
+        case 'C'  :
+            return create_C();
+        case 'F'  :
+            return fork_F();
+        case 'K'  :
+            return kill_K(id);
+        case 'E'  :
+            return exit_E();
+        case 'Q'  :
+            return quantum_Q();
+        case 'S'  :
+            return send_S(id, msg);
+        case 'R'  :
+            return receive_R(val ? id : MAILBOXANY);
+        case 'Y'  :
+            return reply_Y(id, msg);
+        case 'N'  :
+            return sem_N(id, val);
+        case 'P'  :
+            return sem_P(id);
+        case 'V'  :
+            return sem_V(id);
+        case 'D'  :
+            return sem_D(id);
+        case 'I'  :
+            return procinfo_I(id);
+        case 'T'  :
+            return totalinfo_T();
+        case 'O'  :
+            return overview_O();
+        case 'A'  :
+            return accounting_A();
+        case 'L'  :
+            return renice_L(id, (unsigned int) val);
+        case 'X'  :
+            return realtime_X(id, (unsigned int) val, extra);
+        case 'U'  :
+            return cpu_U(id);
+    }
+    return -1;
+}
+
+// maps the whole file at path read-only and stores its size in *size
+// returns the mapping (NULL for an empty file) or MAP_FAILED on failure
+static const char *mapTrace(const char *path, size_t *size) {
+    struct stat st;
+    const char *trace;
+
+    int fd = open(path, O_RDONLY);
+    if (fd < 0 || fstat(fd, &st)) {
+        perror(path);
+        if (fd >= 0)
+            close(fd);
+        return MAP_FAILED;
+    }
+    *size = (size_t) st.st_size;
+    if (st.st_size == 0) {     // mmap() rejects empty mappings
+        close(fd);
+        return NULL;
+    }
+    trace = mmap(NULL, *size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);      // the mapping stays valid after close
+    if (trace == MAP_FAILED)
+        perror(path);
+    else
+        posix_madvise((void *) trace, *size, POSIX_MADV_SEQUENTIAL);
+    return trace;
+}
+
+// replays a text trace, one line at a time
+static void runText(const char *path, const char *trace, size_t size) {
+    const char *line, *eol;
+    const char *end = trace + size;
+    unsigned long lineNum = 0;
+    traceCmd cmd;
+
+    for (line = trace; line < end && run; line = eol + 1) {
+        eol = memchr(line, '\n', (size_t) (end - line));
+        if (!eol)
+            eol = end;
+        lineNum++;
+        switch (traceParseLine(line, eol, &cmd)) {
+            case 0:
+                traceExec(cmd.flag, cmd.id, cmd.val, cmd.extra, cmd.msg);
+                break;
+            case -1:
+                fprintf(stderr, "%s:%lu: invalid command \"%.*s\" skipped\n", path, lineNum, (int) (eol - line), line);
+                break;
+        }
+    }
+}
+
+// validates the layout of a binary trace once, so that its records can then be used without any check
+// returns 0 if it is valid, -1 if it is corrupted
+static int checkBinary(const char *path, const char *trace, size_t size) {
+    const traceHeader *header = (const traceHeader *) trace;
+    const traceRecord *records = (const traceRecord *) (trace + sizeof(traceHeader));
+    uint64_t i;
+
+    if (size < sizeof(traceHeader) || header->numRecords > (size - sizeof(traceHeader)) / sizeof(traceRecord) ||
+        header->strTableSize != size - sizeof(traceHeader) - header->numRecords * sizeof(traceRecord) ||
+        (header->strTableSize && trace[size - 1] != '\0')) {
+        fprintf(stderr, "%s: corrupted binary trace\n", path);
+        return -1;
+    }
+    for (i = 0; i < header->numRecords; i++) {
+        if ((records[i].op == 'S' || records[i].op == 'Y') && records[i].msgOff >= header->strTableSize) {
+            fprintf(stderr, "%s: corrupted binary trace (record #%lu)\n", path, (unsigned long) i);
+            return -1;
+        }
+    }
+    return 0;
+}
+
+// replays a binary trace, the records are dispatched as they are
+// returns 0 on success, -1 if the trace is corrupted
+static int runBinary(const char *path, const char *trace, size_t size) {
+    const traceHeader *header = (const traceHeader *) trace;
+    const traceRecord *records = (const traceRecord *) (trace + sizeof(traceHeader));
+    const char *strTable = (const char *) (records + header->numRecords);
+    uint64_t i;
+
+    if (checkBinary(path, trace, size))
+        return -1;
+
+    // msgOff holds the budget of an X, not an offset
+    for (i = 0; i < header->numRecords && run; i++)
+        traceExec((char) records[i].op, records[i].id, records[i].val, records[i].msgOff,
+                  records[i].op == 'X' ? NULL : (char *) strTable + records[i].msgOff);
+    return 0;
+}
+
+int traceRun(const char *path) {
+    size_t size;
+    int returnVal = 0;
+
+    const char *trace = mapTrace(path, &size);
+    if (trace == MAP_FAILED)
+        return -1;
+    if (!trace)     // empty trace, nothing to replay
+        return 0;
+
+    if (size >= sizeof(traceHeader) && !memcmp(trace, TRACEMAGIC, sizeof TRACEMAGIC))
+        returnVal = runBinary(path, trace, size);
+    else
+        runText(path, trace, size);
+
+    munmap((void *) trace, size);
+    return returnVal;
+}
+
+int traceCmdsAdd(traceCmds *cmds, const traceCmd *cmd) {
+    if (cmds->count == cmds->cap) {
+        size_t newCap = cmds->cap ? cmds->cap * 2 : 1024;
+        traceCmd *newCmds = realloc(cmds->cmds, newCap * sizeof(traceCmd));
+        if (!newCmds)
+            return -1;
+        cmds->cmds = newCmds;
+        cmds->cap = newCap;
+    }
+    cmds->cmds[cmds->count++] = *cmd;
+    return 0;
+}
+
+int traceLoad(const char *path, traceCmds *cmds) {
+    size_t size;
+    int returnVal = 0;
+
+    const char *trace = mapTrace(path, &size);
+    if (trace == MAP_FAILED)
+        return -1;
+    if (!trace)     // empty trace, nothing to load
+        return 0;
+
+    if (size >= sizeof(traceHeader) && !memcmp(trace, TRACEMAGIC, sizeof TRACEMAGIC)) {
+        const traceHeader *header = (const traceHeader *) trace;
+        const traceRecord *records = (const traceRecord *) (trace + sizeof(traceHeader));
+        const char *strTable = (const char *) (records + header->numRecords);
+        uint64_t i;
+        traceCmd cmd;
+
+        returnVal = checkBinary(path, trace, size);
+        for (i = 0; !returnVal && i < header->numRecords; i++) {
+            memset(&cmd, 0, sizeof cmd);
+            cmd.flag = (char) records[i].op;
+            cmd.id = records[i].id;
+            cmd.val = records[i].val;
+            // msgOff holds the budget of an X, not an offset
+            if (cmd.flag == 'X')
+                cmd.extra = records[i].msgOff;
+            else if (cmd.flag == 'S' || cmd.flag == 'Y')
+                strncpy(cmd.msg, strTable + records[i].msgOff, TRACEMSGSIZE - 1);
+            returnVal = traceCmdsAdd(cmds, &cmd);
+        }
+    } else {
+        const char *line, *eol;
+        const char *end = trace + size;
+        unsigned long lineNum = 0;
+        traceCmd cmd;
+
+        for (line = trace; line < end && !returnVal; line = eol + 1) {
+            eol = memchr(line, '\n', (size_t) (end - line));
+            if (!eol)
+                eol = end;
+            lineNum++;
+            switch (traceParseLine(line, eol, &cmd)) {
+                case 0:
+                    returnVal = traceCmdsAdd(cmds, &cmd);
+                    break;
+                case -1:
+                    fprintf(stderr, "%s:%lu: invalid command \"%.*s\" left out\n", path, lineNum, (int) (eol - line),
+                            line);
+                    break;
+            }
+        }
+    }
+    if (returnVal)
+        fprintf(stderr, "%s: the trace could not be loaded\n", path);
+
+    munmap((void *) trace, size);
+    return returnVal;
+}
+
+void traceReplay(const traceCmds *cmds) {
+    size_t i;
+    for (i = 0; i < cmds->count && run; i++)
+        traceExec(cmds->cmds[i].flag, cmds->cmds[i].id, cmds->cmds[i].val, cmds->cmds[i].extra,
+                  (char *) cmds->cmds[i].msg);
+}
+
+void traceWriteText(FILE *out, const traceCmd *cmd) {
+    switch (cmd->flag) {
+        case 'K':
+        case 'I':
+        case 'P':
+        case 'V':
+        case 'D':
+        case 'U':
+            fprintf(out, "%c %u\n", cmd->flag, cmd->id);
+            break;
+        case 'S':
+        case 'Y':
+            fprintf(out, "%c %u %s\n", cmd->flag, cmd->id, cmd->msg);
+            break;
+        case 'N':
+        case 'L':
+            fprintf(out, "%c %u %d\n", cmd->flag, cmd->id, cmd->val);
+            break;
+        case 'X':
+            fprintf(out, "X %u %d %u\n", cmd->id, cmd->val, cmd->extra);
+            break;
+        case 'R':
+            if (cmd->val)
+                fprintf(out, "R %u\n", cmd->id);
+            else
+                fputs("R\n", out);
+            break;
+        default:
+            fprintf(out, "%c\n", cmd->flag);
+    }
+}
+
+traceWriter *traceWriterOpen(const char *path) {
+    traceWriter *writer = calloc(1, sizeof(traceWriter));
+    if (!writer)
+        return NULL;
+    writer->path = path;
+    writer->out = fopen(path, "wb");
+    if (!writer->out) {
+        perror(path);
+        free(writer);
+        return NULL;
+    }
+    memcpy(writer->header.magic, TRACEMAGIC, sizeof TRACEMAGIC);
+    fwrite(&writer->header, sizeof writer->header, 1, writer->out);     // rewritten once the counts are known
+    return writer;
+}
+
+int traceWriterAdd(traceWriter *writer, const traceCmd *cmd) {
+    traceRecord record;
+
+    memset(&record, 0, sizeof record);
+    record.op = (uint8_t) cmd->flag;
+    record.id = cmd->id;
+    record.val = cmd->val;
+    if (cmd->flag == 'S' || cmd->flag == 'Y') {
+        // messages are often repeated, consecutive identical messages share one string
+        if (!writer->strTableSize || strcmp(writer->strTable + writer->lastMsgOff, cmd->msg)) {
+            size_t msgSize = strlen(cmd->msg) + 1;
+            if (writer->strTableSize + msgSize > UINT32_MAX) {
+                fprintf(stderr, "%s: string table overflow\n", writer->path);
+                return -1;
+            }
+            if (writer->strTableSize + msgSize > writer->strTableCap) {
+                size_t newCap = writer->strTableCap ? writer->strTableCap * 2 : 4096;
+                char *newTable = realloc(writer->strTable, newCap);
+                if (!newTable)
+                    return -1;
+                writer->strTable = newTable;
+                writer->strTableCap = newCap;
+            }
+            memcpy(writer->strTable + writer->strTableSize, cmd->msg, msgSize);
+            writer->lastMsgOff = (uint32_t) writer->strTableSize;
+            writer->strTableSize += msgSize;
+        }
+        record.msgOff = writer->lastMsgOff;
+    } else if (cmd->flag == 'X')
+        record.msgOff = cmd->extra;
+    if (fwrite(&record, sizeof record, 1, writer->out) != 1)
+        return -1;
+    writer->header.numRecords++;
+    return 0;
+}
+
+int traceWriterClose(traceWriter *writer) {
+    writer->header.strTableSize = writer->strTableSize;
+    if (writer->strTableSize)
+        fwrite(writer->strTable, 1, writer->strTableSize, writer->out);
+    rewind(writer->out);
+    fwrite(&writer->header, sizeof writer->header, 1, writer->out);
+
+    int returnVal = ferror(writer->out) ? -1 : 0;
+    if (fclose(writer->out) || returnVal) {
+        perror(writer->path);
+        returnVal = -1;
+    }
+    free(writer->strTable);
+    free(writer);
+    return returnVal;
+}
+
+int traceConvert(const char *inPath, const char *outPath) {
+    size_t size;
+    const char *line, *eol, *end;
+    unsigned long lineNum = 0;
+    traceCmd cmd;
+    int returnVal = 0;
+
+    const char *trace = mapTrace(inPath, &size);
+    if (trace == MAP_FAILED)
+        return -1;
+    traceWriter *writer = traceWriterOpen(outPath);
+    if (!writer) {
+        if (trace)
+            munmap((void *) trace, size);
+        return -1;
+    }
+
+    end = trace ? trace + size : NULL;
+    for (line = trace; line < end; line = eol + 1) {
+        eol = memchr(line, '\n', (size_t) (end - line));
+        if (!eol)
+            eol = end;
+        lineNum++;
+        int parsed = traceParseLine(line, eol, &cmd);
+        if (parsed == -1)
+            fprintf(stderr, "%s:%lu: invalid command \"%.*s\" left out\n", inPath, lineNum, (int) (eol - line), line);
+        if (!parsed && traceWriterAdd(writer, &cmd)) {
+            returnVal = -1;
+            break;
+        }
+    }
+
+    if (traceWriterClose(writer))
+        returnVal = -1;
+    if (trace)
+        munmap((void *) trace, size);
+    return returnVal;
+}
@@ -0,0 +1,112 @@
+//// Batch replay of command traces
+//// A trace holds one command per line, with its arguments on the same line:
+////     C | F | E | Q | T | O | A
+////     R | R [pID]
+////     K [pID] | I [pID] | P [semID] | V [semID] | D [semID]
+////     S [pID] [msg] | Y [pID] [msg] | N [semID] [Initial Value] | L [pID] [priority]
+////     X [period] [deadline] [budget] | U [cpu]
+//// Blank lines and lines starting with '#' are ignored. The trace is memory mapped and dispatched
+//// straight into the command handlers of sim.c, no prompt is printed.
+////
+//// A text trace can be converted once into a binary trace, which is replayed without any parsing:
+////     traceHeader | traceRecord[numRecords] | string table (null terminated messages)
+//// All fields are in host byte order.
+////
+//// Created on: Oct 16, 2026
+#pragma once
+
+#include <stdint.h>
+#include <stdio.h>
+
+#define TRACEMSGSIZE 41     // same as MAILBOXMSGSIZE: 40 char max + null terminator
+
+// one parsed command, ready to be dispatched to the simulator
+typedef struct traceCmd {
+    char flag;              // command letter, upper case
+    unsigned int id;        // pID (K/S/Y/I/L, R if val is 1), semID (N/P/V/D), period (X) or CPU (U)
+    int val;                // semaphore initial value (N), new priority (L), whether a sender is given (R)
+                            // or relative deadline (X)
+    unsigned int extra;     // budget (X)
+    char msg[TRACEMSGSIZE]; // message (S/Y), null terminated
+} traceCmd;
+
+// commands held in memory, e.g. a trace loaded once and replayed by many simulations (see sweep.h)
+// replaying only reads them, so any number of threads can replay the same commands at once
+typedef struct traceCmds {
+    traceCmd *cmds;
+    size_t count;
+    size_t cap;
+} traceCmds;
+
+#define TRACEMAGIC "SIMTRC1"     // first 8 bytes of a binary trace (null terminator included)
+
+// header of a binary trace
+typedef struct traceHeader {
+    char magic[8];
+    uint64_t numRecords;    // number of traceRecord following the header
+    uint64_t strTableSize;  // size in bytes of the string table following the records
+} traceHeader;
+
+// one command of a binary trace, fixed width so that the trace can be walked as an array
+typedef struct traceRecord {
+    uint8_t op;             // command letter, upper case (same as traceCmd::flag)
+    uint8_t reserved[3];
+    uint32_t id;            // pID (K/S/Y/I/L), semID (N/P/V/D), period (X) or CPU (U)
+    int32_t val;            // semaphore initial value (N), new priority (L) or relative deadline (X)
+    uint32_t msgOff;        // offset of the message (S/Y) in the string table, or budget (X)
+} traceRecord;
+
+// binary trace being written. The records are streamed to the file, the string table is kept in memory
+// until traceWriterClose() appends it and fills in the header
+typedef struct traceWriter {
+    const char *path;
+    FILE *out;
+    traceHeader header;
+    char *strTable;
+    size_t strTableSize;
+    size_t strTableCap;
+    uint32_t lastMsgOff;    // offset of the last message added, reused if the next message is the same
+} traceWriter;
+
+// parses the command on [line, end). end points at the '\n' (or the end of the trace)
+// returns 0 on success, 1 if the line is blank or a comment, -1 if the line is invalid
+int traceParseLine(const char *line, const char *end, traceCmd *cmd);
+
+// executes a command on the simulator. msg is only used by S/Y, extra by X, id and val only by the commands
+// taking them
+// returns 0 if the command was carried out, -1 if it was refused or flag is not a command
+int traceExec(char flag, unsigned int id, int val, unsigned int extra, char *msg);
+
+// replays the trace at path until it ends or the simulation shuts down
+// binary traces are recognized by their magic, anything else is replayed as a text trace
+// invalid lines are reported on stderr and skipped
+// returns 0 on success, -1 if the trace could not be opened or is a corrupted binary trace
+int traceRun(const char *path);
+
+// appends cmd to cmds. Returns 0 on success, -1 if out of memory
+int traceCmdsAdd(traceCmds *cmds, const traceCmd *cmd);
+
+// appends every command of the trace at path, text or binary, to cmds
+// invalid lines are reported on stderr and left out
+// returns 0 on success, -1 if the trace could not be opened, is a corrupted binary trace or does not fit in memory
+int traceLoad(const char *path, traceCmds *cmds);
+
+// replays cmds on the simulation of the calling thread until they end or the simulation shuts down
+void traceReplay(const traceCmds *cmds);
+
+// converts the text trace at inPath into a binary trace written at outPath
+// invalid lines are reported on stderr and left out
+// returns 0 on success, -1 on failure
+int traceConvert(const char *inPath, const char *outPath);
+
+// writes cmd as one line of a text trace
+void traceWriteText(FILE *out, const traceCmd *cmd);
+
+// creates the binary trace at path. Returns NULL on failure
+traceWriter *traceWriterOpen(const char *path);
+
+// appends cmd to the binary trace. Returns 0 on success, -1 on failure
+int traceWriterAdd(traceWriter *writer, const traceCmd *cmd);
+
+// completes the binary trace and frees writer. Returns 0 on success, -1 on failure
+int traceWriterClose(traceWriter *writer);
@@ -0,0 +1,87 @@
+//// Typed intrusive queues
+//// A "template" for FIFOs whose links live in the queued objects themselves. QUEUETYPE(name, type) declares
+//// the queue type, QUEUEOPS(name, type, prev, next, owner) generates its operations as static inline
+//// functions on struct type itself: no void *, no casts back and no callbacks, so every link update and
+//// every comparison made while walking a queue is visible to the compiler.
+//// Objects are queued at the head and leave from the tail. Within struct type, prev points towards the head,
+//// next towards the tail (i.e. at the object leaving before this one) and owner at the queue holding the
+//// object, NULL if it sits in none. An object sits in at most one queue of a given set of links at a time.
+////
+//// For a queue type name, QUEUEOPS generates:
+////    void namePush(name *queue, struct type *item)   queues item, which sits in no queue, at the head
+////    struct type *namePop(name *queue)               takes the tail out, NULL if queue is empty
+////    void nameRemove(struct type *item)              takes item out of the queue holding it, if any
+////    void nameSplice(name *dst, name *src)           moves src whole behind dst (its objects leave after
+////                                                    those of dst) and empties src, in O(1): the owner of
+////                                                    the moved objects is left as is, for the caller to fix
+//// QUEUEFOREACH() walks a queue in FIFO order, with the loop body inlined.
+////
+//// Created on: Oct 16, 2026
+#pragma once
+
+#include <stddef.h>     // NULL
+
+#define QUEUETYPE(name, type)                                                               \
+    typedef struct name {                                                                   \
+        struct type *head;      /* most recently queued object */                          \
+        struct type *tail;      /* next object to leave */                                  \
+        unsigned int count;                                                                 \
+    } name;
+
+#define QUEUEOPS(name, type, prev, next, owner)                                             \
+    static inline void name##Push(name *queue, struct type *item) {                         \
+        item->prev = NULL;                                                                  \
+        item->next = queue->head;                                                           \
+        if (queue->head)                                                                    \
+            queue->head->prev = item;                                                       \
+        else                                                                                \
+            queue->tail = item;                                                             \
+        queue->head = item;                                                                 \
+        queue->count++;                                                                     \
+        item->owner = queue;                                                                \
+    }                                                                                       \
+                                                                                            \
+    static inline void name##Unlink(name *queue, struct type *item) {                       \
+        if (item->prev)                                                                     \
+            item->prev->next = item->next;                                                  \
+        else                                                                                \
+            queue->head = item->next;                                                       \
+        if (item->next)                                                                     \
+            item->next->prev = item->prev;                                                  \
+        else                                                                                \
+            queue->tail = item->prev;                                                       \
+        queue->count--;                                                                     \
+        item->prev = item->next = NULL;                                                     \
+        item->owner = NULL;                                                                 \
+    }                                                                                       \
+                                                                                            \
+    static inline struct type *name##Pop(name *queue) {                                     \
+        struct type *item = queue->tail;                                                    \
+        if (item)                                                                           \
+            name##Unlink(queue, item);                                                      \
+        return item;                                                                        \
+    }                                                                                       \
+                                                                                            \
+    static inline void name##Remove(struct type *item) {                                    \
+        if (item->owner)                                                                    \
+            name##Unlink(item->owner, item);                                                \
+    }                                                                                       \
+                                                                                            \
+    static inline void name##Splice(name *dst, name *src) {                                 \
+        if (!src->count)                                                                    \
+            return;                                                                         \
+        /* the oldest object of src leaves right after the newest one of dst */            \
+        src->tail->next = dst->head;                                                        \
+        if (dst->head)                                                                      \
+            dst->head->prev = src->tail;                                                    \
+        else                                                                                \
+            dst->tail = src->tail;                                                          \
+        dst->head = src->head;                                                              \
+        dst->count += src->count;                                                           \
+        *src = (name) {NULL, NULL, 0};                                                      \
+    }
+
+// walks queue (a pointer) in FIFO order, from its tail to its head, with item as the cursor
+// item must not be taken out of the queue by the loop body
+#define QUEUEFOREACH(item, queue, prev) \
+    for ((item) = (queue)->tail; (item); (item) = (item)->prev)
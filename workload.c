@@ -0,0 +1,323 @@
+//// Seeded synthetic workload generator
+//// See workload.h for the interface
+////
+//// Created on: Oct 16, 2026
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <limits.h>
+
+#include "sim.h"
+#include "workload.h"
+
+
+// |-------------------------------------------------------------------------|
+// |                          Helper Functions                               |
+// |-------------------------------------------------------------------------|
+
+// xorshift64* generator: tiny, fast and identical on every platform, unlike rand()
+typedef struct rng {
+    uint64_t state;
+} rng;
+
+static void rngSeed(rng *r, uint64_t seed) {
+    // splitmix64 step, so that close seeds still give unrelated streams (and seed 0 is usable)
+    uint64_t z = seed + 0x9E3779B97F4A7C15ULL;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    r->state = (z ^ (z >> 31)) | 1;
+}
+
+static uint64_t rngNext(rng *r) {
+    r->state ^= r->state >> 12;
+    r->state ^= r->state << 25;
+    r->state ^= r->state >> 27;
+    return r->state * 0x2545F4914F6CDD1DULL;
+}
+
+// uniform value in [0, bound)
+static uint32_t rngBelow(rng *r, uint32_t bound) {
+    return (uint32_t) (((rngNext(r) >> 32) * (uint64_t) bound) >> 32);
+}
+
+// set of pIDs the generator believes to be alive. Unordered, removal swaps in the last element
+typedef struct pidSet {
+    unsigned int *pIDs;
+    size_t count;
+    size_t cap;
+} pidSet;
+
+static int pidSetAdd(pidSet *set, unsigned int pID) {
+    if (set->count == set->cap) {
+        size_t newCap = set->cap ? set->cap * 2 : 1024;
+        unsigned int *newPIDs = realloc(set->pIDs, newCap * sizeof(unsigned int));
+        if (!newPIDs)
+            return -1;
+        set->pIDs = newPIDs;
+        set->cap = newCap;
+    }
+    set->pIDs[set->count++] = pID;
+    return 0;
+}
+
+// returns a random pID from the set, removing it if remove is set. Returns 0 ("init") if the set is empty
+static unsigned int pidSetPick(pidSet *set, rng *r, int remove) {
+    if (!set->count)
+        return 0;
+    size_t i = rngBelow(r, (uint32_t) set->count);
+    unsigned int pID = set->pIDs[i];
+    if (remove)
+        set->pIDs[i] = set->pIDs[--set->count];
+    return pID;
+}
+
+// the pIDs the simulator hands out: its allocation order is replayed on an index of the generator's own,
+// where one placeholder pcb stands for every process
+typedef struct pidModel {
+    pidIndex index;
+    pcb placeholder;
+} pidModel;
+
+// adds the process the next C or F creates to the set
+static void pidModelCreate(pidModel *model, pidSet *set) {
+    if (!pidIndexAdd(&model->index, &model->placeholder))
+        pidSetAdd(set, model->placeholder.pID);
+}
+
+// takes a random process out of the set, as K or E ends it, and frees its pID
+static unsigned int pidModelEnd(pidModel *model, pidSet *set, rng *r) {
+    unsigned int pID = pidSetPick(set, r, 1);
+    pidIndexRemove(&model->index, pID);
+    return pID;
+}
+
+// sink used by workloadRun() for text traces
+static int textSink(const traceCmd *cmd, void *arg) {
+    traceWriteText((FILE *) arg, cmd);
+    return 0;
+}
+
+// sink used by workloadRun() for binary traces
+static int binarySink(const traceCmd *cmd, void *arg) {
+    return traceWriterAdd((traceWriter *) arg, cmd);
+}
+
+
+// |-------------------------------------------------------------------------|
+// |                      Generator Implementations                          |
+// |-------------------------------------------------------------------------|
+
+void workloadDefaults(workloadConfig *cfg) {
+    memset(cfg, 0, sizeof(workloadConfig));
+    cfg->seed = 1;
+    cfg->numCmds = 100000;
+    cfg->createWeight = 20;
+    cfg->forkWeight = 5;
+    cfg->killWeight = 10;
+    cfg->exitWeight = 5;
+    cfg->quantumWeight = 30;
+    cfg->semWeight = 15;
+    cfg->msgWeight = 10;
+    cfg->infoWeight = 5;
+    cfg->forkFanout = 2;
+    cfg->numSems = 5;
+    cfg->semInit = 1;
+    cfg->pPercent = 50;
+    cfg->sendPercent = 40;
+    cfg->receivePercent = 30;
+    cfg->numCpus = 1;
+}
+
+int workloadSetOption(workloadConfig *cfg, const char *option) {
+    const char *value = strchr(option, '=');
+    char *endptr;
+    unsigned long long v;
+    size_t keyLen;
+
+    if (!value || value[1] == '\0')
+        return -1;
+    keyLen = (size_t) (value - option);
+    value++;
+    errno = 0;
+    if (keyLen == 7 && !strncmp(option, "seminit", keyLen)) {   // the only signed option
+        long l = strtol(value, &endptr, 0);
+        if (errno || *endptr || l < -1000000 || l > 1000000)
+            return -1;
+        cfg->semInit = (int) l;
+        return 0;
+    }
+    v = strtoull(value, &endptr, 0);
+    if (errno || *endptr || value[0] == '-')
+        return -1;
+
+#define OPTION(name, field, max) \
+    if (keyLen == sizeof(name) - 1 && !strncmp(option, name, keyLen)) { \
+        if (v > (max)) return -1; \
+        cfg->field = v; \
+        return 0; \
+    }
+    OPTION("seed", seed, UINT64_MAX)
+    OPTION("cmds", numCmds, ULONG_MAX)
+    OPTION("create", createWeight, 1000000)
+    OPTION("fork", forkWeight, 1000000)
+    OPTION("kill", killWeight, 1000000)
+    OPTION("exit", exitWeight, 1000000)
+    OPTION("quantum", quantumWeight, 1000000)
+    OPTION("sem", semWeight, 1000000)
+    OPTION("msg", msgWeight, 1000000)
+    OPTION("info", infoWeight, 1000000)
+    OPTION("cpu", cpuWeight, 1000000)
+    OPTION("fanout", forkFanout, 1000)
+    OPTION("sems", numSems, 1000000)
+    OPTION("p", pPercent, 100)
+    OPTION("send", sendPercent, 100)
+    OPTION("receive", receivePercent, 100)
+    OPTION("cpus", numCpus, MAXCPUS)
+#undef OPTION
+    return -1;
+}
+
+unsigned long workloadGenerate(const workloadConfig *cfg, workloadSink sink, void *arg) {
+    rng r;
+    pidSet live = {NULL, 0, 0};
+    pidModel pids = {PIDINDEXEMPTY};
+    unsigned long numGenerated = 0;
+    traceCmd cmd;
+    unsigned int i;
+
+    // cumulative weights, a command class is picked by drawing below the total
+    const unsigned int weights[] = {cfg->createWeight, cfg->forkWeight, cfg->killWeight, cfg->exitWeight,
+                                    cfg->quantumWeight, cfg->semWeight, cfg->msgWeight, cfg->cpuWeight,
+                                    cfg->infoWeight};
+    const int numClasses = sizeof weights / sizeof weights[0];
+    uint32_t totalWeight = 0;
+    for (i = 0; i < (unsigned int) numClasses; i++)
+        totalWeight += weights[i];
+    if (!totalWeight)
+        return 0;
+
+    rngSeed(&r, cfg->seed);
+    memset(&cmd, 0, sizeof cmd);
+    pidIndexAdd(&pids.index, &pids.placeholder);    // "init", pID 0
+
+// hands cmd to the sink, and stops the generation if the sink asks to (or the stream is long enough)
+#define EMIT() \
+    do { \
+        numGenerated++; \
+        if (sink(&cmd, arg) || numGenerated >= cfg->numCmds) \
+            goto done; \
+    } while (0)
+
+    if (!cfg->numCmds)
+        goto done;
+    for (i = 0; i < cfg->numSems; i++) {
+        cmd.flag = 'N';
+        cmd.id = i;
+        cmd.val = cfg->semInit;
+        EMIT();
+    }
+    cmd.val = 0;
+
+    for (;;) {
+        uint32_t draw = rngBelow(&r, totalWeight);
+        int class = 0;
+        while (draw >= weights[class])
+            draw -= weights[class++];
+        // never kill with nothing believed alive: that would target "init" and end the simulation
+        if ((class == 2 || class == 3) && !live.count)
+            class = 0;
+        // nothing of the previous command carries over, in particular not its message
+        memset(&cmd, 0, sizeof cmd);
+
+        switch (class) {
+            case 0:     // create
+                cmd.flag = 'C';
+                pidModelCreate(&pids, &live);
+                EMIT();
+                break;
+            case 1:     // fork fan-out
+                cmd.flag = 'F';
+                for (i = 0; i < (cfg->forkFanout ? cfg->forkFanout : 1); i++) {
+                    pidModelCreate(&pids, &live);
+                    EMIT();
+                }
+                break;
+            case 2:     // kill
+                cmd.flag = 'K';
+                cmd.id = pidModelEnd(&pids, &live, &r);
+                EMIT();
+                break;
+            case 3:     // exit: the running process is unknown here, forget a random one to keep the count right
+                cmd.flag = 'E';
+                pidModelEnd(&pids, &live, &r);
+                EMIT();
+                break;
+            case 4:     // quantum
+                cmd.flag = 'Q';
+                EMIT();
+                break;
+            case 5:     // semaphore
+                cmd.flag = rngBelow(&r, 100) < cfg->pPercent ? 'P' : 'V';
+                cmd.id = cfg->numSems ? rngBelow(&r, cfg->numSems) : 0;
+                EMIT();
+                break;
+            case 6: {   // messaging
+                uint32_t kind = rngBelow(&r, 100);
+                if (kind < cfg->sendPercent)
+                    cmd.flag = 'S';
+                else if (kind < cfg->sendPercent + cfg->receivePercent)
+                    cmd.flag = 'R';
+                else
+                    cmd.flag = 'Y';
+                if (cmd.flag != 'R') {
+                    cmd.id = pidSetPick(&live, &r, 0);
+                    snprintf(cmd.msg, sizeof cmd.msg, "msg %lu", numGenerated);
+                }
+                EMIT();
+                break;
+            }
+            case 7:     // switch to another CPU
+                cmd.flag = 'U';
+                cmd.id = cfg->numCpus ? rngBelow(&r, cfg->numCpus) : 0;
+                EMIT();
+                break;
+            default:    // info
+                cmd.flag = 'I';
+                cmd.id = pidSetPick(&live, &r, 0);
+                EMIT();
+        }
+    }
+#undef EMIT
+
+done:
+    free(live.pIDs);
+    pidIndexFree(&pids.index);
+    return numGenerated;
+}
+
+int workloadRun(const workloadConfig *cfg, const char *format, const char *path) {
+    if (!strcmp(format, "text")) {
+        FILE *out = strcmp(path, "-") ? fopen(path, "w") : stdout;
+        if (!out) {
+            perror(path);
+            return -1;
+        }
+        workloadGenerate(cfg, textSink, out);
+        int returnVal = ferror(out) ? -1 : 0;
+        if (out != stdout && fclose(out))
+            returnVal = -1;
+        if (returnVal)
+            perror(path);
+        return returnVal;
+    } else if (!strcmp(format, "binary")) {
+        traceWriter *writer = traceWriterOpen(path);
+        if (!writer)
+            return -1;
+        workloadGenerate(cfg, binarySink, writer);
+        return traceWriterClose(writer);
+    }
+    fprintf(stderr, "Unknown workload format \"%s\" (expected text or binary)\n", format);
+    return -1;
+}
@@ -0,0 +1,58 @@
+//// Seeded synthetic workload generator
+//// Produces a reproducible stream of simulator commands: the same configuration (seed included) always
+//// produces the same stream, whether it is written as a text trace, a binary trace or executed in-process
+//// (see sim_runWorkload() in simapi.h).
+////
+//// The mix is controlled by relative weights: at each step one command class is drawn with probability
+//// weight / sum of all weights. Targets of K/S/Y/I are drawn from the processes the generator believes
+//// to be alive. Their pIDs are the ones the simulator hands out, recycled pIDs included: the generator feeds
+//// a PID index of its own the same creations and deaths (see pidindex.h). It cannot know which process an E
+//// ends, nor about creations rejected by the simulator, so a few targets may miss.
+////
+//// Created on: Oct 16, 2026
+#pragma once
+
+#include <stdint.h>
+
+#include "trace.h"
+
+typedef struct workloadConfig {
+    uint64_t seed;
+    unsigned long numCmds;          // number of commands to generate
+    // relative weights of the command classes
+    unsigned int createWeight;      // C: process arrival rate
+    unsigned int forkWeight;        // F
+    unsigned int killWeight;        // K on a live process
+    unsigned int exitWeight;        // E
+    unsigned int quantumWeight;     // Q
+    unsigned int semWeight;         // P/V
+    unsigned int msgWeight;         // S/R/Y
+    unsigned int infoWeight;        // I
+    unsigned int cpuWeight;         // U, 0 by default so that the stream runs on CPU 0 only
+    // shape of each class
+    unsigned int forkFanout;        // number of F emitted back to back by one fork
+    unsigned int numSems;           // semaphores initialized (N) at the start of the stream
+    int semInit;                    // initial value of those semaphores
+    unsigned int pPercent;          // % of semaphore operations that are P: above 50 means contention
+    unsigned int sendPercent;       // % of messaging operations that are S
+    unsigned int receivePercent;    // % of messaging operations that are R, the rest are Y
+    unsigned int numCpus;           // CPUs the U commands pick from, as the simulation is run with --cpus
+} workloadConfig;
+
+// receives each generated command. Returns 0 to continue, non-zero to stop the generation
+typedef int (*workloadSink)(const traceCmd *cmd, void *arg);
+
+// fills cfg with a balanced default mix
+void workloadDefaults(workloadConfig *cfg);
+
+// sets one option given as "key=value" (e.g. "seed=42", "cmds=1000000", "create=10")
+// returns 0 on success, -1 on unknown key or invalid value
+int workloadSetOption(workloadConfig *cfg, const char *option);
+
+// generates cfg->numCmds commands into sink. Returns the number of commands generated
+unsigned long workloadGenerate(const workloadConfig *cfg, workloadSink sink, void *arg);
+
+// generates the workload into a text trace or a binary trace
+// format is "text" or "binary" ("-" as path writes a text trace to stdout)
+// returns 0 on success, -1 on failure
+int workloadRun(const workloadConfig *cfg, const char *format, const char *path);